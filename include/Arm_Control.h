@@ -6,6 +6,8 @@
 #include "Robot_Config.h"
 #include "Arm_Control.h"
 #include "lemlib/api.hpp"
+#include "Command.h"
+#include "Loop_Profiler.h"
 
 
 
@@ -20,14 +22,31 @@ public:
 
 
 
-    // Task management
+    // Command management
     static void StartArmPID(int target);
     static void StopArmPID();
+    static bool IsArmPIDRunning();
 
 private:
-    static void ArmPID(void *param);
-
-    static pros::Task *armTask;
+    /**
+     * @brief Moves the arm to armTargetPosition with a PID, one step per scheduler cycle.
+     */
+    class MoveCommand : public Command {
+        public:
+            MoveCommand() : Command(LIFT) {}
+            void Initialize() override;
+            void Execute() override;
+            bool IsFinished() override;
+            void End(bool interrupted) override;
+
+        private:
+            double error = 0.0;
+            double lastError = 0.0;
+            double integral = 0.0;
+            Loop_Profiler::Profile *profile = nullptr;
+    };
+
+    static MoveCommand moveCommand;
     static int armTargetPosition;
 };
 
@@ -0,0 +1,152 @@
+#pragma once
+#ifndef AUTON_ROUTINE_H
+#define AUTON_ROUTINE_H
+
+#include "lemlib/api.hpp"
+
+/**
+ * @brief One step of an autonomous routine, in field-relative coordinates.
+ *
+ * Steps are plain data so a routine can be written once as a const table and
+ * turned into each alliance's and side's version by a Field_Transform.
+ */
+struct Auton_Step {
+    enum Type : uint8_t {
+        SET_POSE,           ///< Reset odometry to x, y, theta.
+        MOVE_TO_POINT,      ///< Drive to x, y.
+        MOVE_TO_POSE,       ///< Drive to x, y, arriving at heading theta.
+        TURN_TO_HEADING,    ///< Turn in place to theta.
+        SWING_TO_HEADING,   ///< Turn to theta about the locked side.
+        FOLLOW_PATH,        ///< Chain through pathLength of the routine's path points from pathStart.
+        INTAKE,             ///< Run the intake at value (negative reverses, 0 stops).
+        CLAMP,              ///< Clamp the mobile goal if value is non-zero, otherwise release it.
+        ARM,                ///< Move the arm to value, in centidegrees.
+        DOINKER,            ///< Lower the doinker if value is non-zero, otherwise raise it.
+        WAIT,               ///< Wait for timeout milliseconds.
+        AWAIT_MOTION,       ///< Wait for the running motion to finish.
+        AWAIT_DISTANCE      ///< Wait until the robot has moved value inches, or the running motion finishes.
+    };
+
+    Type type;
+    float x;
+    float y;
+    float theta;
+    int timeout;
+    int value;
+    bool forwards;
+    lemlib::DriveSide side;
+    lemlib::AngularDirection direction;
+    int pathStart;
+    int pathLength;
+    bool async = false;     ///< Motions only: go on to the next step while the robot drives.
+
+    static constexpr Auton_Step SetPose(float x, float y, float theta) {
+        return {SET_POSE, x, y, theta, 0, 0, true, lemlib::DriveSide::LEFT, lemlib::AngularDirection::AUTO, 0, 0};
+    }
+
+    static constexpr Auton_Step MoveToPoint(float x, float y, int timeout, bool forwards = true) {
+        return {MOVE_TO_POINT, x, y, 0, timeout, 0, forwards, lemlib::DriveSide::LEFT, lemlib::AngularDirection::AUTO,
+                0, 0};
+    }
+
+    static constexpr Auton_Step MoveToPose(float x, float y, float theta, int timeout, bool forwards = true) {
+        return {MOVE_TO_POSE, x, y, theta, timeout, 0, forwards, lemlib::DriveSide::LEFT,
+                lemlib::AngularDirection::AUTO, 0, 0};
+    }
+
+    static constexpr Auton_Step TurnToHeading(float theta, int timeout,
+                                              lemlib::AngularDirection direction = lemlib::AngularDirection::AUTO) {
+        return {TURN_TO_HEADING, 0, 0, theta, timeout, 0, true, lemlib::DriveSide::LEFT, direction, 0, 0};
+    }
+
+    static constexpr Auton_Step SwingToHeading(float theta, lemlib::DriveSide side, int timeout,
+                                               lemlib::AngularDirection direction = lemlib::AngularDirection::AUTO) {
+        return {SWING_TO_HEADING, 0, 0, theta, timeout, 0, true, side, direction, 0, 0};
+    }
+
+    static constexpr Auton_Step FollowPath(int pathStart, int pathLength, int timeout, bool forwards = true) {
+        return {FOLLOW_PATH, 0, 0, 0, timeout, 0, forwards, lemlib::DriveSide::LEFT, lemlib::AngularDirection::AUTO,
+                pathStart, pathLength};
+    }
+
+    static constexpr Auton_Step Action(Type type, int value) {
+        return {type, 0, 0, 0, 0, value, true, lemlib::DriveSide::LEFT, lemlib::AngularDirection::AUTO, 0, 0};
+    }
+
+    static constexpr Auton_Step Wait(int timeout) {
+        return {WAIT, 0, 0, 0, timeout, 0, true, lemlib::DriveSide::LEFT, lemlib::AngularDirection::AUTO, 0, 0};
+    }
+
+    static constexpr Auton_Step AwaitMotion() {
+        return {AWAIT_MOTION, 0, 0, 0, 0, 0, true, lemlib::DriveSide::LEFT, lemlib::AngularDirection::AUTO, 0, 0};
+    }
+
+    static constexpr Auton_Step AwaitDistance(int inches) {
+        return {AWAIT_DISTANCE, 0, 0, 0, 0, inches, true, lemlib::DriveSide::LEFT, lemlib::AngularDirection::AUTO,
+                0, 0};
+    }
+
+    /**
+     * @brief Returns this motion step made asynchronous.
+     *
+     * The routine carries on with the following steps while the robot drives,
+     * until the next motion, AWAIT_MOTION or AWAIT_DISTANCE step. An asynchronous
+     * FOLLOW_PATH step still waits for every point but the last.
+     */
+    constexpr Auton_Step Async() const {
+        Auton_Step step = *this;
+        step.async = true;
+        return step;
+    }
+};
+
+/**
+ * @brief A routine's steps and the path points its FOLLOW_PATH steps refer to.
+ */
+struct Auton_Routine {
+    const Auton_Step *steps;
+    int stepCount;
+    const lemlib::Pose *path;
+    int pathCount;
+};
+
+/**
+ * @brief Maps field-relative coordinates onto one alliance and starting side.
+ *
+ * Coordinates are lemlib's: inches from the field centre, heading 0 along +y
+ * and increasing clockwise. The field is symmetric under reflection across
+ * its centre line and under half turns, so every starting position is a
+ * mirror and/or a whole number of quarter turns of the one a routine was
+ * written for. Quarter turns keep the transform exact, with no trigonometry.
+ */
+struct Field_Transform {
+    bool mirror;        ///< Reflect across the x = 0 centre line first.
+    int quarterTurns;   ///< Then rotate clockwise about the field centre.
+
+    /**
+     * @brief Transforms a point and heading.
+     */
+    lemlib::Pose Apply(const lemlib::Pose &pose) const;
+
+    /**
+     * @brief Transforms a heading, in degrees.
+     */
+    float ApplyHeading(float heading) const;
+
+    /**
+     * @brief Transforms a swing's locked side, which swaps under reflection.
+     */
+    lemlib::DriveSide ApplySide(lemlib::DriveSide side) const;
+
+    /**
+     * @brief Transforms a forced turn direction, which reverses under reflection.
+     */
+    lemlib::AngularDirection ApplyDirection(lemlib::AngularDirection direction) const;
+
+    /**
+     * @brief Transforms every pose, heading, side and direction of a step.
+     */
+    Auton_Step Apply(const Auton_Step &step) const;
+};
+
+#endif
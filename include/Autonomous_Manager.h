@@ -2,7 +2,11 @@
 #ifndef AUTONOMOUS_MANAGER_H
 #define AUTONOMOUS_MANAGER_H
 
+#include <atomic>
+#include <vector>
 #include "Robot.h"
+#include "Auton_Routine.h"
+#include "Coroutine.h"
 
 /**
  * @class Autonomous_Manager
@@ -11,10 +15,33 @@
  * The Autonomous_Manager class provides methods to execute different autonomous
  * routines based on the selected strategy. It interacts with the Robot object to
  * control various subsystems during the autonomous period of a match.
+ *
+ * The four match routines are one routine, written in field coordinates for
+ * the Red Alliance left side. The other three are generated from it by a
+ * Field_Transform when the routine is prepared, so only one copy is kept.
+ *
+ * Match routines run as a coroutine on the command scheduler rather than on
+ * the autonomous task, so asynchronous motions let the intake, clamp and
+ * doinker act while the robot is still driving without a task per action.
+ * Starting a lemlib motion blocks for a few cycles, so the coroutine hands
+ * each motion to a motion task and only polls it from the scheduler.
  */
 class Autonomous_Manager {
     public:
 
+        /**
+         * @brief Autonomous routines, numbered as the selector buttons and the config store use them.
+         */
+        enum Routine {
+            BLUE_LEFT = 0,
+            BLUE_RIGHT,
+            RED_LEFT,
+            RED_RIGHT,
+            NO_ROUTINE,
+            SKILLS,
+            MACRO       ///< Newest /usd/macro_NNN.bin, played back by Driver_Macro, not by Run.
+        };
+
         /**
          * @brief Constructor for the Autonomous_Manager class.
          * 
@@ -27,44 +54,36 @@ class Autonomous_Manager {
 
 
         /**
-         * @brief Executes the autonomous routine for the Blue Alliance, left side.
+         * @brief Executes the skills autonomous routine.
          *
-         * This method contains the code to be run during the autonomous period for
-         * the Blue Alliance when starting from the left side.
+         * This method contains the code for a skills challenge routine, which is
+         * typically a default routine used for testing or special skills challenges.
          */
-        void BlueMatchLeft();
+        void Skills();
 
         /**
-         * @brief Executes the autonomous routine for the Blue Alliance, right side.
+         * @brief Transforms the match routine for a starting position ahead of time.
          *
-         * This method contains the code to be run during the autonomous period for
-         * the Blue Alliance when starting from the right side.
-         */
-        void BlueMatchRight();
-
-        /**
-         * @brief Executes the autonomous routine for the Red Alliance, left side.
+         * Run prepares the routine itself if needed; preparing it when the
+         * selection is made keeps that work out of the autonomous period.
          *
-         * This method contains the code to be run during the autonomous period for
-         * the Red Alliance when starting from the left side.
+         * @param routine The routine that will be run. Only the four match routines need preparing.
          */
-        void RedMatchLeft();
+        void Prepare(int routine);
 
         /**
-         * @brief Executes the autonomous routine for the Red Alliance, right side.
+         * @brief Executes the routine with the given Routine number.
          *
-         * This method contains the code to be run during the autonomous period for
-         * the Red Alliance when starting from the right side.
+         * @param routine The routine to run. NO_ROUTINE and unknown values do nothing.
+         *
+         * Returns once the routine has finished or been stopped.
          */
-        void RedMatchRight();
+        void Run(int routine);
 
         /**
-         * @brief Executes the skills autonomous routine.
-         *
-         * This method contains the code for a skills challenge routine, which is
-         * typically a default routine used for testing or special skills challenges.
+         * @brief Stops a running match routine and any motion it started.
          */
-        void Skills();
+        void Stop();
 
     private:
         /**
@@ -75,6 +94,75 @@ class Autonomous_Manager {
          * during autonomous routines.
          */
         Robot& robot;
+
+        /**
+         * @brief Runs the prepared steps in order on the command scheduler.
+         */
+        class Step_Coroutine : public Coroutine {
+            public:
+                Step_Coroutine(Autonomous_Manager &manager)
+                    : Coroutine(DRIVETRAIN | INTAKE | MOGO_CLAMP | DOINKER), manager(manager) {}
+                void End(bool interrupted) override;
+
+            protected:
+                bool Resume() override;
+
+            private:
+                const Auton_Step &Current() const { return manager.preparedSteps[stepIndex]; }
+
+                Autonomous_Manager &manager;
+                int stepIndex = 0;
+                int pathIndex = 0;
+        };
+
+        /**
+         * @brief Carries out a step that is not a motion.
+         */
+        void StartStep(const Auton_Step &step);
+
+        /**
+         * @brief Asks the motion task to start a motion step, or one point of a FOLLOW_PATH step.
+         */
+        void RequestMotion(const Auton_Step &step, int pathIndex);
+
+        /**
+         * @brief Returns true once the motion asked for last has been started.
+         */
+        bool MotionStarted() const { return motionStarted; }
+
+        /**
+         * @brief Asks the motion task to cancel every motion.
+         */
+        void RequestCancel();
+
+        /**
+         * @brief Starts a motion step asynchronously.
+         */
+        void StartMotion(const Auton_Step &step);
+
+        /**
+         * @brief Starts the motion to one point of a FOLLOW_PATH step.
+         */
+        void StartPathPoint(const Auton_Step &step, int index);
+
+        /**
+         * @brief Starts and cancels motions for the step coroutine.
+         */
+        static void MotionTask(void *param);
+
+        Step_Coroutine stepCoroutine;           ///< Runs the prepared steps; leaves the arm free for ARM steps.
+
+        pros::Task *motionTask = nullptr;           ///< Starts the motions the coroutine asks for.
+        const Auton_Step *requestedStep = nullptr;  ///< Motion step to start, written before motionRequested.
+        int requestedPathIndex = 0;                 ///< Path point to start when requestedStep is FOLLOW_PATH.
+        lemlib::Pose motionStartPose = lemlib::Pose(0, 0, 0);  ///< Pose when the motion started, written before motionStarted.
+        std::atomic<bool> motionRequested{false};
+        std::atomic<bool> motionStarted{false};
+        std::atomic<bool> cancelRequested{false};
+
+        int preparedRoutine;                    ///< Routine the prepared steps belong to, or NO_ROUTINE.
+        std::vector<Auton_Step> preparedSteps;  ///< Match routine steps for the prepared starting position.
+        std::vector<lemlib::Pose> preparedPath; ///< Path points for the prepared steps.
 };
 
 #endif
\ No newline at end of file
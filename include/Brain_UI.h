@@ -12,6 +12,10 @@
  * The Brain_UI class provides methods for displaying and interacting with the autonomous
  * selection user interface (UI) on the robot's Brain screen. It handles button actions
  * and UI updates for selecting different autonomous modes.
+ *
+ * Each screen is built once, the first time it is shown, and switched to with
+ * lv_scr_load afterwards. Showing a screen again only loads it, so toggling
+ * field control no longer piles new LVGL objects onto the active screen.
  */
 class Brain_UI {
     public:
@@ -28,19 +32,43 @@ class Brain_UI {
          */
         static lv_res_t btn_click_action(lv_obj_t* btn);
 
+        /**
+         * @brief Callback for the Tune button; opens the tuning console.
+         */
+        static lv_res_t tune_click_action(lv_obj_t* btn);
+
+        /**
+         * @brief Callback for the Loops button; opens the loop profiler report.
+         */
+        static lv_res_t loops_click_action(lv_obj_t* btn);
+
+        /**
+         * @brief Callback for the Replay button; turns match log replay on or off.
+         */
+        static lv_res_t replay_click_action(lv_obj_t* btn);
+
 
+        /**
+         * @brief Switches the Brain screen to the match (logo) image.
+         */
         static void DisplayMatchImage();
 
 
         /**
          * @brief Displays the autonomous mode selection UI on the Brain screen.
          *
-         * This static method creates and configures the UI elements for selecting different
-         * autonomous modes. It includes buttons for various modes and updates the screen
-         * with the selected mode.
+         * The selector screen and its buttons are created on the first call. Later
+         * calls only switch back to it, keeping the current selection.
          */
         static void DisplayAutonSelectorUI();
 
+        /**
+         * @brief Returns the 240x240 field image, loading it from the SD card the first time it is needed.
+         *
+         * @return The decoded field image, or nullptr if it could not be loaded.
+         */
+        static const lv_img_dsc_t* GetFieldImage();
+
         /**
          * @brief Stores the index of the currently selected autonomous mode.
          *
@@ -48,6 +76,15 @@ class Brain_UI {
          * on user interactions with the UI buttons.
          */
         static int selectedAuton;
+
+    private:
+        static void BuildAutonSelector();
+        static void BuildMatchImage();
+        static lv_obj_t *CreateAutonButton(int id, lv_style_t *style, lv_align_t align, lv_coord_t x, lv_coord_t y,
+                                           const char *text);
+
+        static lv_obj_t *selectorScreen;
+        static lv_obj_t *matchScreen;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+#ifndef BYTE_RING_H
+#define BYTE_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @class Byte_Ring
+ * @brief Bounded, lock-free single-producer/single-consumer byte ring.
+ *
+ * One task writes whole messages into the ring and one task drains it in
+ * batches. Neither side ever blocks or allocates: a write that does not fit is
+ * dropped and counted, and a drain hands the consumer at most two contiguous
+ * spans straight out of the ring's storage.
+ *
+ * Several producers must not share one ring; use Deferred_Log for messages
+ * that come from more than one task.
+ *
+ * @tparam Capacity Size of the ring in bytes. Must be a power of two.
+ */
+template <uint32_t Capacity> class Byte_Ring {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Byte_Ring capacity must be a power of two");
+
+    public:
+
+        /**
+         * @brief Copies a message into the ring.
+         *
+         * @param data The bytes to write.
+         * @param size The number of bytes to write.
+         * @return True if the whole message was written, false if it was dropped.
+         */
+        bool Write(const void *data, uint32_t size) {
+            uint32_t position = head.load(std::memory_order_relaxed);
+            if (Capacity - (position - tail.load(std::memory_order_acquire)) < size) {
+                overflows.fetch_add(1, std::memory_order_relaxed);
+                droppedBytes.fetch_add(size, std::memory_order_relaxed);
+                return false;
+            }
+
+            uint32_t offset = position & (Capacity - 1);
+            uint32_t first = std::min(size, Capacity - offset);
+            std::memcpy(storage + offset, data, first);
+            std::memcpy(storage, static_cast<const uint8_t *>(data) + first, size - first);
+
+            head.store(position + size, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Passes everything written so far to a consumer in one batch.
+         *
+         * @param sink Called as sink(const uint8_t *data, uint32_t size) once, or
+         *             twice if the pending bytes wrap around the end of the ring.
+         * @return The number of bytes drained.
+         */
+        template <typename Sink> uint32_t Drain(Sink &&sink) {
+            uint32_t start = tail.load(std::memory_order_relaxed);
+            uint32_t end = head.load(std::memory_order_acquire);
+            uint32_t size = end - start;
+            if (size == 0) return 0;
+
+            uint32_t offset = start & (Capacity - 1);
+            uint32_t first = std::min(size, Capacity - offset);
+            sink(storage + offset, first);
+            if (first < size) sink(storage, size - first);
+
+            tail.store(end, std::memory_order_release);
+            return size;
+        }
+
+        /**
+         * @brief Returns the number of bytes waiting to be drained.
+         */
+        uint32_t Size() const {
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Returns how many writes were dropped because the ring was full.
+         */
+        uint32_t GetOverflows() const {
+            return overflows.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns how many bytes were dropped because the ring was full.
+         */
+        uint32_t GetDroppedBytes() const {
+            return droppedBytes.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Discards all pending bytes. Only safe while neither side is running.
+         */
+        void Reset() {
+            head.store(0, std::memory_order_relaxed);
+            tail.store(0, std::memory_order_relaxed);
+            overflows.store(0, std::memory_order_relaxed);
+            droppedBytes.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        uint8_t storage[Capacity];
+        std::atomic<uint32_t> head{0};
+        std::atomic<uint32_t> tail{0};
+        std::atomic<uint32_t> overflows{0};
+        std::atomic<uint32_t> droppedBytes{0};
+};
+
+#endif
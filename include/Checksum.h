@@ -0,0 +1,24 @@
+#pragma once
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstdint>
+
+/**
+ * @brief Computes the CRC-16/CCITT-FALSE of a buffer.
+ *
+ * Shared by the telemetry stream framing and the config store so that both
+ * match the host tools, which use the same polynomial and initial value.
+ */
+inline uint16_t Crc16(const uint8_t *data, uint32_t size) {
+    uint16_t crc = 0xFFFF;
+    for (uint32_t i = 0; i < size; i++) {
+        crc ^= data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+#endif
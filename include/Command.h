@@ -0,0 +1,104 @@
+#pragma once
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Subsystems a command can require, as bits of a requirement mask.
+ */
+enum Subsystem : uint8_t {
+    DRIVETRAIN = 1 << 0,
+    LIFT = 1 << 1,
+    INTAKE = 1 << 2,
+    MOGO_CLAMP = 1 << 3,
+    DOINKER = 1 << 4
+};
+
+/**
+ * @class Command
+ * @brief A unit of robot behaviour run by the Command_Scheduler.
+ *
+ * A command declares the subsystems it uses. The scheduler never runs two
+ * commands that share a subsystem: scheduling a command interrupts whatever
+ * interruptible commands hold its subsystems, and is refused if one of them
+ * is not interruptible. All hooks run on the scheduler task, one short call
+ * per cycle, so a command must never block.
+ */
+class Command {
+    public:
+
+        /**
+         * @brief Where a command is in its life.
+         */
+        enum State : uint8_t {
+            IDLE = 0,   ///< Not scheduled.
+            PENDING,    ///< Scheduled, starting on the next cycle.
+            RUNNING     ///< Running on the scheduler.
+        };
+
+        /**
+         * @param requirements Subsystem bits the command uses.
+         * @param interruptible Whether a later command may take its subsystems.
+         */
+        Command(uint8_t requirements, bool interruptible = true)
+            : requirements(requirements), interruptible(interruptible) {}
+
+        virtual ~Command() = default;
+
+        /**
+         * @brief Called once when the command starts.
+         */
+        virtual void Initialize() {}
+
+        /**
+         * @brief Called every scheduler cycle while the command runs.
+         */
+        virtual void Execute() {}
+
+        /**
+         * @brief Returns true once the command has finished. Checked after every Execute.
+         */
+        virtual bool IsFinished() { return false; }
+
+        /**
+         * @brief Called once when the command finishes or is interrupted.
+         *
+         * @param interrupted True if the command was cancelled or another command took its subsystems.
+         */
+        virtual void End(bool interrupted) {}
+
+        uint8_t GetRequirements() const { return requirements; }
+        bool IsInterruptible() const { return interruptible; }
+
+        /**
+         * @brief Returns true while the command is pending or running.
+         */
+        bool IsScheduled() const { return state.load() != IDLE; }
+
+    private:
+        friend class Command_Scheduler;
+
+        const uint8_t requirements;
+        const bool interruptible;
+        std::atomic<uint8_t> state{IDLE};
+};
+
+/**
+ * @class Function_Command
+ * @brief Command that calls a function every cycle and never finishes.
+ *
+ * Used to turn the driver control functions into default commands.
+ */
+class Function_Command : public Command {
+    public:
+        Function_Command(void (*execute)(), uint8_t requirements) : Command(requirements), execute(execute) {}
+
+        void Execute() override { execute(); }
+
+    private:
+        void (*execute)();
+};
+
+#endif
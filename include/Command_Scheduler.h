@@ -0,0 +1,95 @@
+#pragma once
+#ifndef COMMAND_SCHEDULER_H
+#define COMMAND_SCHEDULER_H
+
+#include "api.h"
+#include "Command.h"
+
+/**
+ * @class Command_Scheduler
+ * @brief Runs every subsystem command cooperatively on a single task.
+ *
+ * Each 10 ms cycle the scheduler runs the periodic hook, applies the
+ * schedule and cancel requests made since the last cycle, executes every
+ * running command once, ends the ones that have finished, and starts the
+ * default command of any subsystem left free. Requests from other tasks are
+ * queued, so command state is only ever touched by the scheduler task and no
+ * command needs a task of its own.
+ */
+class Command_Scheduler {
+    public:
+
+        static constexpr int subsystemCount = 5;
+        static constexpr int maxRunning = 8;
+
+        /**
+         * @brief Starts the scheduler task if it is not already running.
+         */
+        static void Start();
+
+        /**
+         * @brief Stops the scheduler task. Running commands are left as they are.
+         */
+        static void Stop();
+
+        /**
+         * @brief Asks for a command to start on the next cycle.
+         *
+         * Interruptible commands holding any of its subsystems are ended first.
+         * If one of them is not interruptible the request is dropped and the
+         * command goes back to IDLE. Scheduling a running command does nothing,
+         * unless a cancel for it was requested earlier in the same cycle, in
+         * which case it restarts.
+         */
+        static void Schedule(Command *command);
+
+        /**
+         * @brief Asks for a command to be ended on the next cycle, as if interrupted.
+         */
+        static void Cancel(Command *command);
+
+        /**
+         * @brief Sets the command that runs whenever nothing else requires a subsystem.
+         *
+         * @param subsystem The subsystem the command is the default for.
+         * @param command The default command, or nullptr for none.
+         */
+        static void SetDefaultCommand(Subsystem subsystem, Command *command);
+
+        /**
+         * @brief Removes every default command, ending any that are running.
+         */
+        static void ClearDefaultCommands();
+
+        /**
+         * @brief Sets a function run at the start of every cycle, before any command.
+         *
+         * @param periodic The function to run, or nullptr for none.
+         */
+        static void SetPeriodic(void (*periodic)());
+
+    private:
+        struct Request {
+            Command *command;
+            bool cancel;
+        };
+
+        static void SchedulerTask(void *param);
+        static void RunCycle();
+        static void ApplyRequests();
+        static bool Start(Command *command);
+        static void End(int index, bool interrupted);
+
+        static pros::Task *schedulerTask;
+        static pros::Mutex requestMutex;
+        static Request requests[];
+        static int requestCount;
+        static Command *running[maxRunning];
+        static int runningCount;
+        static Command *defaults[subsystemCount];
+        static Command *pendingDefaults[subsystemCount];
+        static void (*periodic)();
+        static void (*pendingPeriodic)();
+};
+
+#endif
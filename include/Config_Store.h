@@ -0,0 +1,91 @@
+#pragma once
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <cstdint>
+#include "api.h"
+
+/**
+ * @brief Everything that should survive a brain reboot.
+ *
+ * New fields must only ever be appended, so older files still load with the
+ * new fields left at their defaults.
+ */
+#pragma pack(push, 1)
+struct StoredConfig {
+    static constexpr int curvePoints = 5;
+
+    int32_t selectedAuton;     ///< Autonomous_Manager::Routine chosen on the selector.
+    uint8_t alliance;          ///< Config_Store::Alliance of the chosen routine.
+    float armGains[3];         ///< Arm PID kP, kI, kD.
+    float lateralGains[3];     ///< lemlib lateral PID kP, kI, kD.
+    float angularGains[3];     ///< lemlib angular PID kP, kI, kD.
+    int32_t armResetPosition;  ///< Rotation sensor position the arm is reset to, in centidegrees.
+    float throttleCurve[curvePoints];  ///< Throttle power at each of Config_Store's curve inputs.
+    float steerCurve[curvePoints];     ///< Steer power at each of Config_Store's curve inputs.
+    float redRingHue;          ///< Optical sensor hue of a red ring, in degrees.
+    float blueRingHue;         ///< Optical sensor hue of a blue ring, in degrees.
+    float ringHueTolerance;    ///< Largest hue difference, in degrees, still counted as a ring's colour.
+};
+#pragma pack(pop)
+
+/**
+ * @class Config_Store
+ * @brief Keeps the robot's configuration on the SD card with a checksum.
+ *
+ * The configuration is a single packed record, so loading it is one small read
+ * at startup. Saves alternate between two files, each stamped with a sequence
+ * number and a CRC, so a save interrupted by a power cut leaves the previous
+ * configuration intact.
+ */
+class Config_Store {
+    public:
+
+        /**
+         * @brief Alliance colours.
+         */
+        enum Alliance : uint8_t {
+            NO_ALLIANCE = 0,
+            RED,
+            BLUE
+        };
+
+        /**
+         * @brief Loads the newest valid configuration from the SD card.
+         *
+         * @return True if a saved configuration was found, false if the defaults are in use.
+         */
+        static bool Load();
+
+        /**
+         * @brief Writes the configuration to the SD card.
+         *
+         * @return True if the configuration was written.
+         */
+        static bool Save();
+
+        /**
+         * @brief Returns the configuration. Call Save after changing it.
+         */
+        static StoredConfig &Get();
+
+        /**
+         * @brief Hands the stored chassis gains to lemlib's PID controllers.
+         */
+        static void ApplyChassisGains();
+
+        /**
+         * @brief Rebuilds the driver curve tables from the stored curve points.
+         */
+        static void ApplyDriveCurves();
+
+    private:
+        static void SetDefaults();
+        static bool ReadSlot(int slot, StoredConfig &loaded, uint32_t &loadedSequence);
+
+        static StoredConfig config;
+        static uint32_t sequence;
+        static int lastSlot;
+};
+
+#endif
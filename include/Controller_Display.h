@@ -0,0 +1,50 @@
+#pragma once
+#ifndef CONTROLLER_DISPLAY_H
+#define CONTROLLER_DISPLAY_H
+
+#include "api.h"
+
+/**
+ * @class Controller_Display
+ * @brief Sends text and rumble patterns to the controller without blocking the caller.
+ *
+ * The controller only accepts one screen update about every 50 ms. Callers
+ * write into a shadow copy of the 3x15 text grid, which costs a format and a
+ * copy, and a background task sends one changed row or queued rumble per
+ * period. Rows that have not changed are never resent.
+ */
+class Controller_Display {
+    public:
+
+        static constexpr int rows = 3;
+        static constexpr int columns = 15;
+
+        /**
+         * @brief Starts the display task for a controller.
+         */
+        static void Start(pros::Controller &controller);
+
+        /**
+         * @brief Sets the text of one row, padded or cut to the row width.
+         *
+         * @param row The row to set, from 0 to 2.
+         * @param format A printf-style format string.
+         */
+        static void Print(int row, const char *format, ...);
+
+        /**
+         * @brief Queues a rumble pattern of '.', '-' and ' ' characters.
+         *
+         * @return False if the queue was full and the pattern was dropped.
+         */
+        static bool Rumble(const char *pattern);
+
+    private:
+        static void DisplayTask(void *param);
+        static bool SendNext();
+
+        static pros::Controller *controller;
+        static pros::Task *displayTask;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef CONTROLLER_SNAPSHOT_H
+#define CONTROLLER_SNAPSHOT_H
+
+#include <cstdint>
+#include "api.h"
+
+/**
+ * @brief Packed copy of every controller stick and button at one instant.
+ *
+ * Driver control reads its inputs from a snapshot instead of straight from
+ * the controller, which lets recorded inputs be played back through exactly
+ * the same code.
+ */
+#pragma pack(push, 1)
+struct ControllerSnapshot {
+    int8_t analog[4];   ///< Stick values, indexed by controller_analog_e_t.
+    uint16_t buttons;   ///< One bit per button, starting at E_CONTROLLER_DIGITAL_L1.
+
+    /**
+     * @brief Reads the current state of a controller.
+     */
+    static ControllerSnapshot Read(pros::Controller &controller) {
+        ControllerSnapshot snapshot{};
+        for (int channel = 0; channel < 4; channel++) {
+            snapshot.analog[channel] = controller.get_analog(static_cast<pros::controller_analog_e_t>(channel));
+        }
+        for (int button = pros::E_CONTROLLER_DIGITAL_L1; button <= pros::E_CONTROLLER_DIGITAL_A; button++) {
+            if (controller.get_digital(static_cast<pros::controller_digital_e_t>(button))) {
+                snapshot.buttons |= 1 << (button - pros::E_CONTROLLER_DIGITAL_L1);
+            }
+        }
+        return snapshot;
+    }
+
+    int GetAnalog(pros::controller_analog_e_t channel) const {
+        return analog[channel];
+    }
+
+    bool GetDigital(pros::controller_digital_e_t button) const {
+        return buttons & (1 << (button - pros::E_CONTROLLER_DIGITAL_L1));
+    }
+
+    bool operator==(const ControllerSnapshot &other) const {
+        return buttons == other.buttons && analog[0] == other.analog[0] && analog[1] == other.analog[1] &&
+               analog[2] == other.analog[2] && analog[3] == other.analog[3];
+    }
+
+    bool operator!=(const ControllerSnapshot &other) const {
+        return !(*this == other);
+    }
+};
+#pragma pack(pop)
+
+#endif
@@ -0,0 +1,113 @@
+#pragma once
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include "api.h"
+#include "lemlib/api.hpp"
+#include "Command.h"
+#include "Robot_Config.h"
+
+extern Robot_Config robotDevices;
+
+/**
+ * @class Coroutine
+ * @brief Command whose body reads as straight-line code but yields while it waits.
+ *
+ * Resume is written between CO_BEGIN and CO_END. Each CO_AWAIT saves the
+ * point it reached and returns to the scheduler until its condition holds,
+ * so many routines and parallel branches share the one scheduler task
+ * instead of each needing an RTOS task and stack. Conditions are plain
+ * expressions, so waiting for all or any of several things is && or ||:
+ *
+ * @code
+ * CO_AWAIT(MotionDone() || Elapsed(1500));
+ * @endcode
+ *
+ * The body resumes with a jump back into a switch statement, so values that
+ * must survive a CO_AWAIT have to be members, not locals, and CO_AWAIT may
+ * not be used inside another switch.
+ *
+ * lemlib's motion calls block their caller for a few cycles, so a coroutine
+ * must not start motions itself; it asks another task to start one, waits for
+ * it to have started and then only polls it.
+ */
+class Coroutine : public Command {
+    public:
+        Coroutine(uint8_t requirements) : Command(requirements) {}
+
+        void Initialize() override {
+            resumePoint = 0;
+            finished = false;
+        }
+
+        void Execute() override { finished = Resume(); }
+
+        bool IsFinished() override { return finished; }
+
+    protected:
+        /**
+         * @brief Runs the body up to its next unmet CO_AWAIT.
+         *
+         * @return True once the body has reached CO_END.
+         */
+        virtual bool Resume() = 0;
+
+        /**
+         * @brief Returns true once the running lemlib motion has finished.
+         */
+        static bool MotionDone() { return !robotDevices.chassis.isInMotion(); }
+
+        /**
+         * @brief Returns true once this many milliseconds have passed since the current CO_AWAIT began.
+         */
+        bool Elapsed(uint32_t milliseconds) const { return pros::millis() - awaitStart >= milliseconds; }
+
+        /**
+         * @brief Returns true once the robot is this many inches from where it was when the last motion started.
+         */
+        bool Traveled(float inches) const { return robotDevices.chassis.getPose().distance(motionPose) >= inches; }
+
+        /**
+         * @brief Returns true once every given command has finished or been interrupted.
+         */
+        template <typename... Commands> static bool AllDone(const Commands &...commands) {
+            return (!commands.IsScheduled() && ...);
+        }
+
+        /**
+         * @brief Returns true once any given command has finished or been interrupted.
+         */
+        template <typename... Commands> static bool AnyDone(const Commands &...commands) {
+            return (!commands.IsScheduled() || ...);
+        }
+
+        int resumePoint = 0;
+        uint32_t awaitStart = 0;
+        lemlib::Pose motionPose = lemlib::Pose(0, 0, 0);  ///< Pose when the last motion started; set by the subclass.
+
+    private:
+        bool finished = false;
+};
+
+/**
+ * @brief Starts a Coroutine body. Must be the first statement of Resume.
+ */
+#define CO_BEGIN switch (resumePoint) { case 0:
+
+/**
+ * @brief Yields to the scheduler until a condition holds.
+ */
+#define CO_AWAIT(condition)                                 \
+    do {                                                    \
+        resumePoint = __LINE__;                             \
+        awaitStart = pros::millis();                        \
+        case __LINE__:                                      \
+        if (!(condition)) return false;                     \
+    } while (0)
+
+/**
+ * @brief Ends a Coroutine body. Must be the last statement of Resume.
+ */
+#define CO_END } return true;
+
+#endif
@@ -0,0 +1,130 @@
+#pragma once
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include "pros/rtos.hpp"
+#include "lemlib/logger/message.hpp"
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+
+/**
+ * @class Deferred_Log
+ * @brief Logger that moves message formatting off the calling task.
+ *
+ * lemlib's sinks format every message twice on the task that logs it. This
+ * logger only copies the format string pointer, which doubles as the message
+ * ID, and the raw argument bytes into a fixed, lock-free queue. A background
+ * task formats the queued messages later and prints them to the terminal, so
+ * logging from a control loop costs a few stores and never touches the heap.
+ *
+ * Arguments must be trivially copyable, and any string argument must be a
+ * literal because only its pointer is stored.
+ */
+class Deferred_Log {
+    public:
+
+        /**
+         * @brief Starts the background formatting task.
+         */
+        static void Start();
+
+        /**
+         * @brief Sets the lowest level that will be queued.
+         */
+        static void SetLowestLevel(lemlib::Level level);
+
+        /**
+         * @brief Returns how many messages were dropped because the queue was full.
+         */
+        static uint32_t GetDroppedMessages();
+
+        /**
+         * @brief Queues a message for deferred formatting.
+         *
+         * @param level The severity of the message.
+         * @param format A string literal in fmt syntax.
+         * @param args The arguments to substitute into the format.
+         */
+        template <typename... T> static void Log(lemlib::Level level, const char *format, T... args) {
+            static_assert((std::is_trivially_copyable_v<T> && ...), "Deferred_Log arguments must be trivially copyable");
+            static_assert((sizeof(T) + ... + 0) <= argCapacity, "Deferred_Log arguments are too large");
+
+            if (level < lowestLevel) return;
+
+            Entry *entry = Reserve();
+            if (entry == nullptr) return;
+
+            uint32_t offset = 0;
+            ((std::memcpy(entry->args + offset, &args, sizeof(T)), offset += sizeof(T)), ...);
+            entry->time = pros::millis();
+            entry->level = level;
+            entry->format = format;
+            entry->formatter = &FormatEntry<T...>;
+            Publish(entry);
+        }
+
+        template <typename... T> static void Debug(const char *format, T... args) {
+            Log(lemlib::Level::DEBUG, format, args...);
+        }
+
+        template <typename... T> static void Info(const char *format, T... args) {
+            Log(lemlib::Level::INFO, format, args...);
+        }
+
+        template <typename... T> static void Warn(const char *format, T... args) {
+            Log(lemlib::Level::WARN, format, args...);
+        }
+
+        template <typename... T> static void Error(const char *format, T... args) {
+            Log(lemlib::Level::ERROR, format, args...);
+        }
+
+        template <typename... T> static void Fatal(const char *format, T... args) {
+            Log(lemlib::Level::FATAL, format, args...);
+        }
+
+    private:
+        static constexpr uint32_t argCapacity = 48;
+
+        struct Entry {
+            std::atomic<uint32_t> sequence;
+            uint32_t time;
+            lemlib::Level level;
+            const char *format;
+            void (*formatter)(const Entry &entry, fmt::memory_buffer &out);
+            uint8_t args[argCapacity];
+        };
+
+        /**
+         * @brief Rebuilds the captured arguments and formats them into a buffer.
+         */
+        template <typename... T> static void FormatEntry(const Entry &entry, fmt::memory_buffer &out) {
+            std::tuple<T...> captured;
+            std::apply([&](T &...values) {
+                uint32_t offset = 0;
+                ((std::memcpy(&values, entry.args + offset, sizeof(T)), offset += sizeof(T)), ...);
+                fmt::format_to(std::back_inserter(out), fmt::runtime(entry.format), values...);
+            }, captured);
+        }
+
+        struct Queue;
+
+        static Entry *Reserve();
+        static void Publish(Entry *entry);
+        static void DrainTask(void *param);
+        static bool Drain();
+
+        static Queue queue;
+        static pros::Task *drainTask;
+        static lemlib::Level lowestLevel;
+        static std::atomic<uint32_t> enqueuePosition;
+        static uint32_t dequeuePosition;
+        static std::atomic<uint32_t> droppedMessages;
+};
+
+#endif
@@ -0,0 +1,168 @@
+#pragma once
+#ifndef DRIVE_CURVE_TABLE_H
+#define DRIVE_CURVE_TABLE_H
+
+#include "lemlib/chassis/chassis.hpp"
+
+/**
+ * @brief lemlib's exponential drive curve, written as a shape to build a table from.
+ *
+ * Uses std::pow, so a table built from it is filled at startup instead of at
+ * compile time. The driver loop never evaluates it directly.
+ */
+struct Expo_Shape {
+    float deadband;
+    float minOutput;
+    float gain;
+
+    float operator()(float input) const;
+};
+
+/**
+ * @brief Monotone cubic spline through control points on the positive half of the stick.
+ *
+ * The curve is mirrored for negative inputs. Tangents are the average of the
+ * neighbouring slopes, clamped to three times the smaller one, which keeps the
+ * curve from overshooting between points without needing a square root, so
+ * a spline with fixed points can be built at compile time.
+ *
+ * @tparam Points Number of control points.
+ */
+template <int Points> struct Spline_Shape {
+    static_assert(Points >= 2, "Spline_Shape needs at least two points");
+
+    float x[Points];
+    float y[Points];
+    float slope[Points];
+
+    /**
+     * @brief Builds the spline.
+     *
+     * @param inputs Stick positions of the control points, increasing from 0 to 127.
+     * @param outputs Drive power at each control point, never decreasing.
+     */
+    constexpr Spline_Shape(const float (&inputs)[Points], const float (&outputs)[Points]) : x{}, y{}, slope{} {
+        float secant[Points - 1] = {};
+        for (int i = 0; i < Points; i++) {
+            x[i] = inputs[i];
+            y[i] = outputs[i];
+        }
+        for (int i = 0; i < Points - 1; i++) {
+            secant[i] = (y[i + 1] - y[i]) / (x[i + 1] - x[i]);
+        }
+
+        slope[0] = secant[0];
+        slope[Points - 1] = secant[Points - 2];
+        for (int i = 1; i < Points - 1; i++) {
+            float before = secant[i - 1];
+            float after = secant[i];
+            if (before <= 0.0f || after <= 0.0f) {
+                slope[i] = 0.0f;
+            } else {
+                float limit = 3.0f * (before < after ? before : after);
+                float average = (before + after) / 2.0f;
+                slope[i] = average < limit ? average : limit;
+            }
+        }
+    }
+
+    constexpr float operator()(float input) const {
+        float magnitude = input < 0.0f ? -input : input;
+        float sign = input < 0.0f ? -1.0f : 1.0f;
+
+        if (magnitude <= x[0]) return sign * y[0];
+        if (magnitude >= x[Points - 1]) return sign * y[Points - 1];
+
+        int i = 0;
+        while (magnitude > x[i + 1]) i++;
+
+        // Cubic Hermite basis on this segment
+        float h = x[i + 1] - x[i];
+        float t = (magnitude - x[i]) / h;
+        float t2 = t * t;
+        float t3 = t2 * t;
+        float value = (2 * t3 - 3 * t2 + 1) * y[i] + (t3 - 2 * t2 + t) * h * slope[i] +
+                      (-2 * t3 + 3 * t2) * y[i + 1] + (t3 - t2) * h * slope[i + 1];
+        return sign * value;
+    }
+};
+
+/**
+ * @class Drive_Curve_Table
+ * @brief Drive curve that is evaluated by table lookup.
+ *
+ * The table holds one entry for every whole stick position from -128 to 127,
+ * so a joystick reading is shaped with a single array read and a fractional
+ * input with one linear interpolation. It can be built from any shape: a
+ * lambda, a Spline_Shape, an Expo_Shape, or an existing lemlib curve wrapped in
+ * a lambda. Shapes that are constexpr give a table built at compile time.
+ *
+ * Passing a table to lemlib's Chassis shapes arcade, curvature and tank drive
+ * the same way, without lemlib evaluating an exponential every call.
+ */
+class Drive_Curve_Table : public lemlib::DriveCurve {
+    public:
+        static constexpr int tableSize = 256;
+
+        /**
+         * @brief Builds a straight-line table, which leaves inputs unchanged.
+         */
+        constexpr Drive_Curve_Table() : table{} {
+            for (int i = 0; i < tableSize; i++) {
+                table[i] = Clamp(i - tableOffset);
+            }
+        }
+
+        /**
+         * @brief Builds a table from a shape.
+         *
+         * @param shape Called as shape(float input) for inputs from -127 to 127.
+         */
+        template <typename Shape> constexpr explicit Drive_Curve_Table(const Shape &shape) : table{} {
+            Build(shape);
+        }
+
+        /**
+         * @brief Refills the table from a new shape.
+         *
+         * A driver loop reading the table while it is refilled sees a mix of
+         * old and new entries for at most one cycle.
+         *
+         * @param shape Called as shape(float input) for inputs from -127 to 127.
+         */
+        template <typename Shape> constexpr void Build(const Shape &shape) {
+            for (int i = 0; i < tableSize; i++) {
+                table[i] = Clamp(shape(static_cast<float>(Clamp(i - tableOffset))));
+            }
+        }
+
+        /**
+         * @brief Shapes a whole stick position.
+         *
+         * @param input Stick position, from -127 to 127.
+         */
+        float Lookup(int input) const {
+            if (input < -tableOffset) input = -tableOffset;
+            if (input > tableSize - 1 - tableOffset) input = tableSize - 1 - tableOffset;
+            return table[input + tableOffset];
+        }
+
+        /**
+         * @brief Shapes an input, interpolating between table entries.
+         *
+         * @param input Stick position, from -127 to 127.
+         * @return The shaped drive power.
+         */
+        float curve(float input) override;
+
+    private:
+        static constexpr int tableOffset = 128;
+
+        static constexpr float Clamp(float value) {
+            return value < -127.0f ? -127.0f : (value > 127.0f ? 127.0f : value);
+        }
+
+        float table[tableSize];
+};
+
+#endif
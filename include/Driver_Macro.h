@@ -0,0 +1,111 @@
+#pragma once
+#ifndef DRIVER_MACRO_H
+#define DRIVER_MACRO_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "api.h"
+#include "lemlib/api.hpp"
+#include "Byte_Ring.h"
+#include "Controller_Snapshot.h"
+
+/**
+ * @class Driver_Macro
+ * @brief Records a driver run and plays it back as an autonomous routine.
+ *
+ * While recording, the controller input of every driver control iteration is
+ * delta-encoded against the previous one, so an unchanged loop costs nothing
+ * and a moved stick costs a few bytes. An odometry keyframe is stored every
+ * 200 ms. Playback feeds the input back through the driver control code, but
+ * runs the macro clock slower or faster depending on whether the robot is
+ * behind or ahead of the recorded path, and steers the tank sticks towards
+ * the recorded heading, so drift does not build up over a long run.
+ *
+ * Each frame is a change mask, the time since the previous frame as a
+ * varint, then only the changed fields: a wrapping int8 difference per stick,
+ * the buttons XORed with the previous buttons, and an absolute pose.
+ */
+class Driver_Macro {
+    public:
+
+        /**
+         * @brief Bits of a frame's change mask.
+         */
+        enum FrameMask : uint8_t {
+            ANALOG = 0x0F,    ///< One bit per stick channel, indexed by controller_analog_e_t.
+            BUTTONS = 0x10,   ///< uint16 XOR of the button bits.
+            POSE = 0x20       ///< int16 x, y (0.01 in) and heading (0.01 deg).
+        };
+
+        /**
+         * @brief Opens a new /usd/macro_NNN.bin and starts recording.
+         *
+         * @return True if the SD card was available and recording started.
+         */
+        static bool StartRecording();
+
+        /**
+         * @brief Stops recording. The writer task writes out what is still buffered and closes the file.
+         */
+        static void StopRecording();
+
+        /**
+         * @brief Returns true while a macro is being recorded.
+         */
+        static bool IsRecording();
+
+        /**
+         * @brief Records one driver control iteration.
+         *
+         * @param input The controller input the iteration used.
+         */
+        static void Record(const ControllerSnapshot &input);
+
+        /**
+         * @brief Plays a recorded macro back. Blocks until the macro has finished.
+         *
+         * @param path The macro file to play.
+         * @param apply Called every playback iteration with the corrected input,
+         *              normally running the driver control functions.
+         * @return False if the file was missing or not a macro.
+         */
+        static bool Play(const char *path, void (*apply)(const ControllerSnapshot &input));
+
+        /**
+         * @brief Plays the newest /usd/macro_NNN.bin back. Blocks until the macro has finished.
+         *
+         * @return False if no macro has been recorded on the card.
+         */
+        static bool PlayLatest(void (*apply)(const ControllerSnapshot &input));
+
+    private:
+        struct Frame {
+            uint32_t time;
+            ControllerSnapshot input;
+        };
+
+        struct Keyframe {
+            uint32_t time;
+            lemlib::Pose pose;
+        };
+
+        static bool Load(const char *path, std::vector<Frame> &frames, std::vector<Keyframe> &keyframes);
+        static lemlib::Pose PoseAt(const std::vector<Keyframe> &keyframes, size_t &index, double time);
+        static void WriterTask(void *param);
+
+        static pros::Task *writerTask;
+        static FILE *macroFile;
+        static Byte_Ring<4096> frameRing;
+        static std::atomic<bool> recording;
+        static std::atomic<bool> stopRequested;
+        static std::atomic<bool> writerRunning;
+        static ControllerSnapshot lastInput;
+        static uint32_t lastFrameTime;
+        static uint32_t lastKeyframeTime;
+        static bool started;
+        static uint32_t droppedFrames;
+};
+
+#endif
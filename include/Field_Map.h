@@ -0,0 +1,58 @@
+#pragma once
+#ifndef FIELD_MAP_H
+#define FIELD_MAP_H
+
+#include "api.h"
+#include "lemlib/api.hpp"
+#include "Loop_Profiler.h"
+
+/**
+ * @class Field_Map
+ * @brief Draws the robot's live pose, odometry trail and planned path over the field.
+ *
+ * The map is an lv_canvas on its own screen, drawn by an LVGL task at a
+ * capped rate, so only LVGL's own task touches the canvas. Pixels are written straight into the canvas buffer and only the
+ * rectangles that changed are invalidated, so LVGL redraws a few small areas
+ * per update instead of the whole map. Nothing is drawn while another screen
+ * is showing.
+ */
+class Field_Map {
+    public:
+
+        /**
+         * @brief Switches the Brain screen to the field map, building it on first use.
+         */
+        static void Show();
+
+        /**
+         * @brief Sets the planned path drawn under the robot.
+         *
+         * @param points The path's waypoints in field inches; copied, so they need not outlive the call.
+         * @param count The number of waypoints. Extra waypoints beyond maxPathPoints are ignored.
+         */
+        static void SetPath(const lemlib::Pose *points, int count);
+
+        /**
+         * @brief Clears the odometry trail.
+         */
+        static void ClearTrail();
+
+        static constexpr int maxPathPoints = 32;
+
+    private:
+        static void MapTask(void *param);
+        static void Update();
+        static void Redraw();
+        static void RestoreBackground(const lv_area_t &area);
+        static void DrawLine(lv_point_t from, lv_point_t to, lv_color_t color, const lv_area_t &clip, lv_area_t &bounds);
+        static void DrawOverlays(const lv_area_t &clip);
+        static void DrawRobot(const lemlib::Pose &pose, lv_area_t &bounds);
+        static void Invalidate(const lv_area_t &area);
+
+        static lv_obj_t *mapScreen;
+        static lv_obj_t *canvas;
+        static lv_color_t *buffer;
+        static Loop_Profiler::Profile *loopProfile;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+#ifndef FILE_INDEX_H
+#define FILE_INDEX_H
+
+#include <cstddef>
+#include <cstdio>
+
+/**
+ * @class File_Index
+ * @brief Hands out numbered file names on the SD card, such as /usd/match_007.bin.
+ *
+ * The next free number of each name is kept in a small counter file next to
+ * the numbered files, so opening a new file costs a couple of small reads and
+ * writes however many earlier files the card holds, rather than probing every
+ * number until one is free.
+ */
+class File_Index {
+    public:
+
+        /**
+         * @brief Creates the next numbered file of a name.
+         *
+         * @param name Base name of the files, such as "match".
+         * @param extension Extension including the dot, such as ".bin".
+         * @param mode fopen mode to create the file with.
+         * @return The open file, or nullptr if it could not be created.
+         */
+        static FILE *OpenNext(const char *name, const char *extension, const char *mode);
+
+        /**
+         * @brief Returns the number of the newest file of a name, or -1 if none has been created.
+         */
+        static int GetLatest(const char *name);
+
+        /**
+         * @brief Writes the path of a numbered file into a buffer.
+         */
+        static void FormatPath(char *path, size_t size, const char *name, int index, const char *extension);
+
+    private:
+        static int ReadCounter(const char *name);
+        static void WriteCounter(const char *name, int next);
+};
+
+#endif
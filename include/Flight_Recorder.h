@@ -0,0 +1,90 @@
+#pragma once
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include "api.h"
+#include "Telemetry.h"
+
+/**
+ * @class Flight_Recorder
+ * @brief Keeps the last few seconds of telemetry in RAM and dumps it on a fault.
+ *
+ * Telemetry samples are copied into a fixed ring that simply overwrites its
+ * oldest entry, so recording costs one small copy per sample. A high-priority
+ * watchdog task looks for control loops that have stopped making progress and
+ * for the robot being disabled. When either happens, a low-priority writer
+ * task copies the ring and writes it to the SD card along with the state of
+ * every watched task and the most recent PROS errno values.
+ */
+class Flight_Recorder {
+    public:
+
+        /**
+         * @brief Starts the watchdog and dump writer tasks if they are not already running.
+         */
+        static void Start();
+
+        /**
+         * @brief Watches a task's loop for stalls.
+         *
+         * @param taskName The name the task was created with.
+         * @param profileName The Loop_Profiler profile that times the task's loop.
+         * @param timeout How long the loop may go without an iteration, in ms.
+         */
+        static void Watch(const char *taskName, const char *profileName, uint32_t timeout);
+
+        /**
+         * @brief Adds a telemetry sample to the ring.
+         */
+        static void Push(const TelemetryRecord &record);
+
+        /**
+         * @brief Remembers a non-zero errno value for the next dump.
+         */
+        static void NoteErrno(int error);
+
+        /**
+         * @brief Asks the writer task to write the ring and task state to the SD card.
+         *
+         * Does not wait for the write, so it may be called from any task.
+         *
+         * @param reason A short description of why the dump was taken. Must outlive the dump.
+         */
+        static void Dump(const char *reason);
+
+    private:
+        struct Watched {
+            const char *taskName;
+            const char *profileName;
+            uint32_t timeout;
+            uint32_t lastCount;
+            uint32_t lastProgress;
+            bool stalled;
+        };
+
+        struct ErrnoEntry {
+            uint32_t time;
+            int error;
+        };
+
+        static void WatchdogTask(void *param);
+        static void WriterTask(void *param);
+        static void WriteDump(const char *reason);
+
+        static pros::Task *watchdogTask;
+        static pros::Task *writerTask;
+        static std::atomic<const char *> pendingReason;
+        static pros::Mutex ringMutex;
+        static TelemetryRecord ring[];
+        static uint32_t ringHead;
+        static ErrnoEntry errors[];
+        static uint32_t errorHead;
+        static TelemetryRecord ringSnapshot[];
+        static ErrnoEntry errorSnapshot[];
+        static Watched watched[];
+        static int watchedCount;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef IMAGE_ASSET_H
+#define IMAGE_ASSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include "api.h"
+#include "lemlib/asset.hpp"
+
+/**
+ * @class Image_Asset
+ * @brief Decodes compressed Brain screen images into LVGL image descriptors.
+ *
+ * Images are packed on the host by tools/image_pack.py as 24-bit colour in a
+ * single LZ4 block, about a quarter of their true-colour size. Large images
+ * are copied to the SD card and loaded from there, so they are not part of
+ * the uploaded program at all; small ones can still be linked in from static/
+ * as assets. Each image is decoded once, straight into the pixel buffer LVGL
+ * draws from, the first time it is needed.
+ */
+class Image_Asset {
+    public:
+
+        /**
+         * @brief Decodes a packed image into a new LVGL true-colour image.
+         *
+         * The pixel buffer is allocated here and lives for the rest of the
+         * program, so decode each image once and keep the descriptor.
+         *
+         * @param source The packed image asset.
+         * @param image Filled in with the decoded image's descriptor.
+         * @return True if the image was decoded, false if it was corrupt or memory ran out.
+         */
+        static bool Decode(const asset &source, lv_img_dsc_t &image);
+
+        /**
+         * @brief Reads a packed image file and decodes it into a new LVGL true-colour image.
+         *
+         * @param path The packed image file, normally on /usd.
+         * @param image Filled in with the decoded image's descriptor.
+         * @return True if the image was decoded, false if the file was missing or corrupt or memory ran out.
+         */
+        static bool Load(const char *path, lv_img_dsc_t &image);
+
+    private:
+        static bool Decompress(const uint8_t *block, size_t blockSize, uint8_t *output, size_t outputSize);
+};
+
+#endif
@@ -2,6 +2,9 @@
 #ifndef INTAKE_CONTROL_H
 #define INTAKE_CONTROL_H
 
+#include <cstdint>
+#include "Command.h"
+
 /**
  * @class Intake_Control
  * @brief Manages the intake system of the robot.
@@ -9,10 +12,25 @@
  * The Intake_Control class provides functions to control the intake mechanism,
  * including intaking and outtaking at specific velocities, stopping the intake,
  * checking possession of rings, and retrieving the current intake status.
+ *
+ * While sorting is on, the optical sensor classifies each ring as it enters
+ * and the intake motor's encoder tracks it up the hooks. A ring of the
+ * rejected colour gets a short reverse pulse timed to the encoder position
+ * at which it tops the hooks, which flings it off while every other ring
+ * passes at full intake speed.
  */
 class Intake_Control {
     public:
 
+        /**
+         * @brief Ring colours the optical sensor can tell apart.
+         */
+        enum Ring : uint8_t {
+            NO_RING = 0,
+            RED_RING,
+            BLUE_RING
+        };
+
         /**
          * @brief Intakes objects at a specified velocity.
          * 
@@ -38,6 +56,54 @@ class Intake_Control {
          */
         void StopIntake();
 
+        /**
+         * @brief Starts rejecting rings of one colour.
+         *
+         * @param reject The colour to eject. NO_RING tracks rings without ejecting any.
+         */
+        static void StartSorting(Ring reject);
+
+        /**
+         * @brief Stops sorting and forgets the rings being tracked.
+         */
+        static void StopSorting();
+
+        /**
+         * @brief Returns the colour of a ring from its hue, using the stored hue calibration.
+         *
+         * @param hue Optical sensor hue, in degrees.
+         */
+        static Ring ClassifyHue(double hue);
+
+    private:
+        static constexpr int maxTrackedRings = 4;
+
+        /**
+         * @brief Tracks rings past the optical sensor and fires the eject pulses.
+         *
+         * It requires no subsystem, so it runs alongside whichever command is
+         * driving the intake and only overrides the motor during a pulse.
+         */
+        class SortCommand : public Command {
+            public:
+                SortCommand() : Command(0) {}
+                void Initialize() override;
+                void Execute() override;
+                void End(bool interrupted) override;
+        };
+
+        static void ApplyPower();
+
+        static SortCommand sortCommand;
+        static Ring rejectColor;
+        static int commandedPower;                      ///< Power last asked for by Intake, Outtake or StopIntake.
+        static bool ejecting;
+        static uint32_t ejectStart;
+        static bool ringAtSensor;
+        static bool ringClassified;
+        static double ringEntryPosition;                ///< Motor position when the current ring reached the sensor.
+        static double ejectPositions[maxTrackedRings];  ///< Motor positions at which tracked rings top the hooks.
+        static int ejectCount;
 
 };
 
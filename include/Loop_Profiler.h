@@ -0,0 +1,124 @@
+#pragma once
+#ifndef LOOP_PROFILER_H
+#define LOOP_PROFILER_H
+
+#include <cstdint>
+#include "api.h"
+#include "pros/apix.h"
+
+/**
+ * @class Loop_Profiler
+ * @brief Measures how long control loop iterations take.
+ *
+ * Each instrumented loop registers a profile with a deadline, then wraps its
+ * loop body in a Scope. Iteration times are sorted into fixed histogram
+ * buckets and any iteration longer than the deadline is counted as a miss.
+ * Recording is a few integer operations under an uncontended mutex, so
+ * profiles can stay on in a match. Other tasks read a profile through
+ * Snapshot, so its 64-bit total is never read half written.
+ * The report can be printed to the terminal or shown on its own brain screen
+ * page, opened from the autonomous selector.
+ */
+class Loop_Profiler {
+    public:
+
+        static constexpr int bucketCount = 10;
+
+        /**
+         * @brief Upper edge of each histogram bucket, in microseconds.
+         */
+        static constexpr uint32_t bucketEdges[bucketCount] = {
+            50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, UINT32_MAX
+        };
+
+        /**
+         * @brief Timing statistics for one loop.
+         */
+        struct Profile {
+            const char *name;
+            uint32_t deadline;
+            uint32_t count;
+            uint32_t misses;
+            uint32_t worst;
+            uint64_t total;
+            uint32_t buckets[bucketCount];
+        };
+
+        /**
+         * @brief Times one loop iteration from construction to destruction.
+         */
+        class Scope {
+            public:
+                Scope(Profile *profile) : profile(profile), start(pros::micros()) {}
+                ~Scope() { Record(profile, pros::micros() - start); }
+
+            private:
+                Profile *profile;
+                uint64_t start;
+        };
+
+        /**
+         * @brief Registers a loop to be profiled.
+         *
+         * @param name A string literal naming the loop.
+         * @param deadline The longest an iteration may take, in microseconds.
+         * @return The loop's profile, or nullptr if the profile table is full.
+         */
+        static Profile *Register(const char *name, uint32_t deadline);
+
+        /**
+         * @brief Looks up a registered profile by name.
+         *
+         * @return The profile, or nullptr if no loop registered that name.
+         */
+        static const Profile *Find(const char *name);
+
+        /**
+         * @brief Adds one iteration time to a profile.
+         *
+         * @param profile The profile to update. Ignored if nullptr.
+         * @param elapsed The iteration time, in microseconds.
+         */
+        static void Record(Profile *profile, uint32_t elapsed);
+
+        /**
+         * @brief Returns a consistent copy of a profile's statistics.
+         */
+        static Profile Snapshot(const Profile &profile);
+
+        /**
+         * @brief Returns the bucket edge below which a fraction of iterations finished.
+         *
+         * @param profile The profile to query.
+         * @param fraction The percentile as a fraction, e.g. 0.99.
+         */
+        static uint32_t Percentile(const Profile &profile, double fraction);
+
+        /**
+         * @brief Clears the statistics of every profile.
+         */
+        static void Reset();
+
+        /**
+         * @brief Prints every profile and its histogram to the terminal.
+         */
+        static void PrintReport();
+
+        /**
+         * @brief Switches the Brain screen to the profiler report, building it on first use.
+         */
+        static void ShowReport();
+
+    private:
+        static void BuildReport();
+        static void RefreshReport(void *param);
+        static lv_res_t BackAction(lv_obj_t *btn);
+
+        static Profile profiles[];
+        static int profileCount;
+        static pros::Mutex profileMutex;
+        static lv_obj_t *reportScreen;
+        static lv_obj_t *reportLabel;
+};
+
+#endif
@@ -0,0 +1,127 @@
+#pragma once
+#ifndef MATCH_RECORDER_H
+#define MATCH_RECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "api.h"
+#include "Byte_Ring.h"
+#include "Controller_Snapshot.h"
+
+/**
+ * @class Match_Recorder
+ * @brief Records controller input, competition state and sensors, and replays the input.
+ *
+ * While recording, every change in controller input, every competition state
+ * transition, the selected autonomous and a periodic sensor snapshot are
+ * written to a compact binary log on the SD card. Recording runs for the life
+ * of the program; the log is flushed every few hundred milliseconds.
+ *
+ * Replay is an input replay, not a deterministic one: it plays
+ * /usd/replay.bin's controller input and autonomous selection back
+ * open-loop through the normal driver control code. The recorded sensor
+ * snapshots are not used to correct the robot; they are only there to be
+ * compared offline with tools/match_decode.py, so a replay drifts from the
+ * recorded match just as the driver's inputs would. Driver_Macro covers the
+ * same ground for single runs and does correct for drift against its recorded
+ * poses. Replay is opt-in from the selector screen and is refused or ended
+ * whenever the robot is connected to a field or competition switch.
+ */
+class Match_Recorder {
+    public:
+
+        /**
+         * @brief Record types stored in a match log.
+         */
+        enum RecordType : uint8_t {
+            CONTROLLER = 1,     ///< uint32 time, ControllerSnapshot
+            COMPETITION = 2,    ///< uint32 time, uint8 competition status
+            AUTONOMOUS = 3,     ///< uint32 time, int32 selected autonomous
+            SENSORS = 4         ///< uint32 time, SensorSnapshot
+        };
+
+        /**
+         * @brief Sensor readings stored with each SENSORS record.
+         */
+        #pragma pack(push, 1)
+        struct SensorSnapshot {
+            float poseX;
+            float poseY;
+            float poseTheta;
+            float imuHeading;
+            int32_t armAngle;
+            int32_t verticalTicks;
+            int32_t horizontalTicks;
+        };
+        #pragma pack(pop)
+
+        /**
+         * @brief Starts recording a new match log.
+         *
+         * @param controller The controller to record.
+         */
+        static void Start(pros::Controller &controller);
+
+        /**
+         * @brief Plays /usd/replay.bin back in place of the controller.
+         *
+         * @return False if the robot is connected to a field or competition
+         *         switch, or the file is missing or not a match log.
+         */
+        static bool StartReplay();
+
+        /**
+         * @brief Hands control back to the controller.
+         */
+        static void StopReplay();
+
+        /**
+         * @brief Returns true while a recorded log is being played back.
+         */
+        static bool IsReplaying();
+
+        /**
+         * @brief Returns the controller input for this driver control iteration.
+         *
+         * Live input is recorded whenever it changes. During replay the input
+         * recorded at the same point in the match is returned instead.
+         */
+        static ControllerSnapshot Poll();
+
+        /**
+         * @brief Records the selected autonomous, or returns the recorded one during replay.
+         *
+         * @param selected The autonomous chosen on the brain screen.
+         * @return The autonomous to run.
+         */
+        static int SelectAutonomous(int selected);
+
+    private:
+        struct ReplayEvent {
+            uint32_t time;
+            ControllerSnapshot input;
+        };
+
+        static bool LoadReplay(const char *path);
+        static void RecorderTask(void *param);
+        static void WriteRecord(RecordType type, uint32_t time, const void *data, uint32_t size);
+
+        static pros::Controller *controller;
+        static pros::Task *recorderTask;
+        static FILE *logFile;
+        static Byte_Ring<4096> inputRing;
+        static ControllerSnapshot lastInput;
+        static bool hasInput;
+        static int autonomous;
+
+        static std::atomic<bool> replaying;
+        static bool replayStarted;
+        static std::vector<ReplayEvent> replayEvents;
+        static size_t replayIndex;
+        static uint32_t replayOffset;
+        static int replayAutonomous;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef MICRO_BENCHMARK_H
+#define MICRO_BENCHMARK_H
+
+#include <cstdint>
+#include "api.h"
+
+/**
+ * @class Micro_Benchmark
+ * @brief Times the control math that runs inside the robot's loops.
+ *
+ * Every benchmark runs a primitive in a tight batch and reports the median
+ * nanoseconds per call over several batches, timed with pros::micros. Results
+ * are printed as CSV lines starting with "BENCH" and saved to the SD card, so
+ * tools/benchmark_compare.py can check them against a saved baseline. The
+ * brain reports no pass or fail of its own: without a measured baseline there
+ * is nothing honest to judge a result against.
+ */
+class Micro_Benchmark {
+    public:
+
+        /**
+         * @brief The timing result of one benchmark.
+         */
+        struct Result {
+            const char *name;
+            uint32_t nanoseconds;
+        };
+
+        /**
+         * @brief Runs every benchmark and reports the results.
+         *
+         * Blocks for about a second, so only call it while the robot is disabled.
+         */
+        static void Run();
+
+        /**
+         * @brief Returns the results of the last run.
+         *
+         * @param count Set to the number of results.
+         */
+        static const Result *GetResults(int &count);
+
+    private:
+        static uint32_t Measure(void (*batch)(int iterations));
+        static void Report();
+
+        static Result results[];
+        static int resultCount;
+};
+
+#endif
@@ -26,6 +26,11 @@ class Mogo_Clamp {
          */
         void Unclamp();
 
+        /**
+         * @brief Returns whether the clamp is currently engaged.
+         */
+        bool IsClamped() const;
+
     private:
         bool isClamped; ///< Indicates whether the clamp is currently engaged.
 };
@@ -0,0 +1,104 @@
+#pragma once
+#ifndef POWER_GOVERNOR_H
+#define POWER_GOVERNOR_H
+
+#include <atomic>
+#include "pros/rtos.hpp"
+#include "Robot_Config.h"
+
+extern Robot_Config robotDevices;
+
+/**
+ * @class Power_Governor
+ * @brief Shares the brain's current budget between the drive, arm and intake.
+ *
+ * The governor runs as a background task that reads motor current draws,
+ * battery voltage and the thermal model's derating. It hands out the available current to each
+ * motor group in priority order and writes the result back as per-motor current
+ * limits, so the firmware never has to throttle everything at once during a
+ * pushing match.
+ */
+class Power_Governor {
+    public:
+
+        /**
+         * @brief Motor groups that compete for the current budget.
+         */
+        enum Group {
+            DRIVE = 0,
+            ARM,
+            INTAKE,
+            GROUP_COUNT
+        };
+
+        /**
+         * @brief Starts the governor task if it is not already running.
+         */
+        static void Start();
+
+        /**
+         * @brief Stops the governor task and restores the default motor limits.
+         */
+        static void Stop();
+
+        /**
+         * @brief Returns the motors that belong to a group.
+         *
+         * @param group The motor group to query.
+         * @param count Set to the number of motors in the group.
+         */
+        static pros::Motor *const *GetMotors(Group group, int &count);
+
+        /**
+         * @brief Sets the priority of a motor group.
+         *
+         * @param group The motor group to configure.
+         * @param priority Higher values are served first when the budget is short.
+         */
+        static void SetPriority(Group group, int priority);
+
+        /**
+         * @brief Scales a driver drive command by the current drive allocation.
+         *
+         * @param power The raw drive command (-127 to 127).
+         * @return The command scaled so that both sides keep their ratio.
+         */
+        static int ScaleDrive(int power);
+
+        /**
+         * @brief Returns the fraction of requested drive current that was granted.
+         *
+         * @return Drive scale between 0 and 1, not including traction control.
+         */
+        static double GetDriveScale();
+
+        /**
+         * @brief Sets the extra drive scale requested by traction control.
+         *
+         * @param scale Fraction of drive output to allow, between 0 and 1.
+         */
+        static void SetTractionScale(double scale);
+
+        /**
+         * @brief Returns the current limit, in mA, granted to each motor of a group.
+         *
+         * @param group The motor group to query.
+         */
+        static int GetMotorLimit(Group group);
+
+    private:
+        static void GovernorTask(void *param);
+        static void Allocate();
+        static void ApplyLimits(Group group, int limit);
+        static void WriteDriveLimit();
+
+        static pros::Task *governorTask;
+        static int priorities[GROUP_COUNT];
+        static int motorLimits[GROUP_COUNT];
+        static std::atomic<double> driveScale;
+        static std::atomic<double> tractionScale;
+        static pros::Mutex driveLimitMutex;
+        static int driveVoltageLimit;
+};
+
+#endif
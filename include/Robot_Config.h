@@ -4,6 +4,7 @@
 
 #include "lemlib/api.hpp"
 #include "pros/optical.hpp"
+#include "Drive_Curve_Table.h"
 
 using namespace pros;
 
@@ -52,6 +53,11 @@ class Robot_Config {
     // PID CONTROLLERS
         lemlib::ControllerSettings lateralController;
         lemlib::ControllerSettings angularController;
+
+    // DRIVER CURVES
+        Drive_Curve_Table throttleCurve;
+        Drive_Curve_Table steerCurve;
+
         lemlib::Chassis chassis;
 
     Robot_Config();
@@ -0,0 +1,68 @@
+#pragma once
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <cstdint>
+#include "api.h"
+
+/**
+ * @class Task_Monitor
+ * @brief Watches the CPU share of the robot's tasks and whether they are still running.
+ *
+ * A low-priority task samples every watched task once a period. CPU share and
+ * deadline misses come from the task's Loop_Profiler profile. A warning is
+ * logged when a watched task that was running disappears, when its CPU share
+ * goes over a limit, or when its loop missed deadlines since the last sample,
+ * and the controller rumbles when a task first runs into trouble.
+ *
+ * Stack headroom is not reported: the PROS kernel does not export a stack
+ * high-water mark query to user code.
+ */
+class Task_Monitor {
+    public:
+
+        /**
+         * @brief Adds a task to the watch list.
+         *
+         * @param taskName The name the task was created with.
+         * @param profileName The Loop_Profiler profile that times the task's loop, if any.
+         * @param mayExit True for tasks that end on their own, which are then not warned about when they stop.
+         */
+        static void Watch(const char *taskName, const char *profileName = nullptr, bool mayExit = false);
+
+        /**
+         * @brief Starts the monitor task if it is not already running.
+         */
+        static void Start();
+
+        /**
+         * @brief Stops the monitor task.
+         */
+        static void Stop();
+
+        /**
+         * @brief Prints the CPU share and state of every watched task.
+         */
+        static void PrintReport();
+
+    private:
+        struct Watched {
+            const char *taskName;
+            const char *profileName;
+            bool mayExit;
+            uint64_t lastBusy;
+            uint32_t lastMisses;
+            float cpuShare;
+            bool running;
+            bool warning;
+        };
+
+        static void MonitorTask(void *param);
+        static void Sample(uint32_t elapsed);
+
+        static pros::Task *monitorTask;
+        static Watched watched[];
+        static int watchedCount;
+};
+
+#endif
@@ -0,0 +1,153 @@
+#pragma once
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include "pros/rtos.hpp"
+#include "Byte_Ring.h"
+
+/**
+ * @brief One packed telemetry sample.
+ *
+ * Every field is a fixed-width channel, so a record can be copied straight
+ * into the ring buffer and onto the SD card without any formatting. The layout
+ * is described to the host decoder by the channel table written at the start
+ * of every log file.
+ */
+#pragma pack(push, 1)
+struct TelemetryRecord {
+    uint32_t timestamp;       ///< Milliseconds since program start.
+    float poseX;              ///< Odometry X, in inches.
+    float poseY;              ///< Odometry Y, in inches.
+    float poseTheta;          ///< Odometry heading, in degrees.
+    int16_t leftVelocity;     ///< Left drive velocity, in RPM.
+    int16_t rightVelocity;    ///< Right drive velocity, in RPM.
+    int16_t armVelocity;      ///< Arm motor velocity, in RPM.
+    int16_t intakeVelocity;   ///< Intake motor velocity, in RPM.
+    int16_t leftCurrent;      ///< Left drive current draw, in mA.
+    int16_t rightCurrent;     ///< Right drive current draw, in mA.
+    int16_t armCurrent;       ///< Arm current draw, in mA.
+    int16_t intakeCurrent;    ///< Intake current draw, in mA.
+    float armP;               ///< Arm PID proportional term.
+    float armI;               ///< Arm PID integral term.
+    float armD;               ///< Arm PID derivative term.
+    int32_t armAngle;         ///< Arm rotation sensor position, in centidegrees.
+    uint16_t batteryVoltage;  ///< Battery voltage, in mV.
+    float lateralP;           ///< lemlib lateral PID proportional term.
+    float lateralI;           ///< lemlib lateral PID integral term.
+    float lateralD;           ///< lemlib lateral PID derivative term, from the error change since the last sample.
+    float angularP;           ///< lemlib angular PID proportional term.
+    float angularI;           ///< lemlib angular PID integral term.
+    float angularD;           ///< lemlib angular PID derivative term, from the error change since the last sample.
+};
+#pragma pack(pop)
+
+/**
+ * @class Telemetry
+ * @brief Records control-loop state to the SD card as packed binary records.
+ *
+ * A sampling task fills a preallocated byte ring at the loop rate and a
+ * low-priority task writes the buffer to /usd in large blocks. Nothing is
+ * formatted or allocated while logging; tools/telemetry_decode.py turns the
+ * resulting files back into CSV on the host.
+ */
+class Telemetry {
+    public:
+
+        /**
+         * @brief Channel value types understood by the host decoder.
+         */
+        enum ChannelType : uint8_t {
+            U16 = 0,
+            I16,
+            U32,
+            I32,
+            F32
+        };
+
+        /**
+         * @brief Describes one field of TelemetryRecord.
+         */
+        #pragma pack(push, 1)
+        struct Channel {
+            char name[16];
+            uint8_t type;
+            uint16_t offset;
+        };
+        #pragma pack(pop)
+
+        /**
+         * @brief Returns the channel table describing TelemetryRecord.
+         *
+         * @param count Set to the number of channels in the table.
+         */
+        static const Channel *GetChannels(uint16_t &count);
+
+        /**
+         * @brief Returns the size in bytes of a channel value type.
+         */
+        static uint8_t GetChannelSize(uint8_t type);
+
+        /**
+         * @brief Per-caller state Capture needs between records.
+         *
+         * Each task that captures records keeps its own, so the chassis PID
+         * derivatives are taken over that task's own sample interval.
+         */
+        struct CaptureState {
+            float lastLateralError = 0.0f;
+            float lastAngularError = 0.0f;
+        };
+
+        /**
+         * @brief Fills a record with the current robot state.
+         *
+         * @param state The calling task's state from its previous capture.
+         */
+        static void Capture(TelemetryRecord &record, CaptureState &state);
+
+        /**
+         * @brief Opens a new log file and starts the sampling and flush tasks.
+         *
+         * @return True if the SD card was available and logging started.
+         */
+        static bool Start();
+
+        /**
+         * @brief Stops sampling and writes everything left in the ring buffer.
+         *
+         * The tasks are asked to stop and left to finish their current sample
+         * or write, so the log file is never closed under a write.
+         */
+        static void Stop();
+
+        /**
+         * @brief Publishes the latest arm PID terms for the next sample.
+         */
+        static void SetArmPID(float p, float i, float d);
+
+        /**
+         * @brief Returns how many records were dropped because the buffer was full.
+         */
+        static uint32_t GetDroppedRecords();
+
+    private:
+        static void SampleTask(void *param);
+        static void FlushTask(void *param);
+        static void Sample();
+        static void Flush();
+        static void WriteHeader();
+
+        static pros::Task *sampleTask;
+        static pros::Task *flushTask;
+        static FILE *logFile;
+        static Byte_Ring<32768> ring;
+        static float armTerms[3];
+        static CaptureState captureState;
+        static std::atomic<bool> stopRequested;
+        static std::atomic<int> runningTasks;
+};
+
+#endif
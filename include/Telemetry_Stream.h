@@ -0,0 +1,65 @@
+#pragma once
+#ifndef TELEMETRY_STREAM_H
+#define TELEMETRY_STREAM_H
+
+#include <atomic>
+#include <cstdint>
+#include "pros/rtos.hpp"
+#include "Telemetry.h"
+
+/**
+ * @class Telemetry_Stream
+ * @brief Streams telemetry channels to a host over the USB serial link.
+ *
+ * Frames are a type byte and payload followed by a CRC-16, COBS encoded and
+ * surrounded by zero delimiters. Nothing is sent until the host subscribes to
+ * a set of channels and a period; the brain answers with a description of the
+ * subscribed channels and then sends only those values. tools/telemetry_viewer.py
+ * is the matching host receiver.
+ *
+ * Only the send task writes to the serial link; a subscription received by the
+ * receive task is answered by the send task on its next cycle.
+ */
+class Telemetry_Stream {
+    public:
+
+        /**
+         * @brief Frame types exchanged with the host.
+         */
+        enum FrameType : uint8_t {
+            SUBSCRIBE = 0x01,   ///< Host to brain: uint32 channel mask, uint16 period in ms.
+            DESCRIBE = 0x02,    ///< Brain to host: uint16 period, uint8 total, uint8 first, then channels first onwards.
+            DATA = 0x10         ///< Brain to host: subscribed channel values in table order.
+        };
+
+        /**
+         * @brief Switches the serial link to raw frames and starts the stream tasks.
+         */
+        static void Start();
+
+        /**
+         * @brief Stops streaming and returns the serial link to PROS multiplexing.
+         */
+        static void Stop();
+
+        /**
+         * @brief Returns how many received frames failed the CRC check.
+         */
+        static uint32_t GetBadFrames();
+
+    private:
+        static void ReceiveTask(void *param);
+        static void SendTask(void *param);
+        static void HandleFrame(const uint8_t *frame, uint32_t size);
+        static void SendFrame(const uint8_t *frame, uint32_t size);
+        static void SendDescription(uint32_t mask, uint32_t period);
+
+        static pros::Task *receiveTask;
+        static pros::Task *sendTask;
+        static std::atomic<uint32_t> channelMask;
+        static std::atomic<uint32_t> period;
+        static std::atomic<bool> describePending;
+        static uint32_t badFrames;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef THERMAL_MODEL_H
+#define THERMAL_MODEL_H
+
+#include "api.h"
+#include "Power_Governor.h"
+
+/**
+ * @class Thermal_Model
+ * @brief Predicts motor temperature and derates motors before they overheat.
+ *
+ * Each motor's temperature is integrated from its current squared with a
+ * first-order heating and cooling model. The firmware only reports temperature
+ * in 5 degree steps, so the model is pulled towards the reported value only
+ * when it falls outside that step. From the estimate, the model predicts how
+ * long each motor group can keep its present load before reaching the limit
+ * and hands the power governor a smooth derating factor.
+ */
+class Thermal_Model {
+    public:
+
+        /**
+         * @brief Starts the thermal model task if it is not already running.
+         */
+        static void Start();
+
+        /**
+         * @brief Returns the output fraction a group should be limited to.
+         *
+         * @return 1 when the group has plenty of headroom, falling smoothly as it nears its limit.
+         */
+        static double GetDerate(Power_Governor::Group group);
+
+        /**
+         * @brief Returns the predicted seconds until the hottest motor of a group reaches its limit.
+         *
+         * @return Seconds of headroom at the present load, capped at maxHeadroom.
+         */
+        static double GetHeadroom(Power_Governor::Group group);
+
+        /**
+         * @brief Returns the estimated temperature of the hottest motor in a group.
+         */
+        static double GetTemperature(Power_Governor::Group group);
+
+        static constexpr double maxHeadroom = 999.0;
+
+    private:
+        static void ThermalTask(void *param);
+        static void Update(double dt);
+
+        static pros::Task *thermalTask;
+        static double derate[Power_Governor::GROUP_COUNT];
+        static double headroom[Power_Governor::GROUP_COUNT];
+        static double temperature[Power_Governor::GROUP_COUNT];
+};
+
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+#ifndef TRACTION_CONTROL_H
+#define TRACTION_CONTROL_H
+
+#include "pros/rtos.hpp"
+#include "Robot_Config.h"
+
+extern Robot_Config robotDevices;
+
+/**
+ * @class Traction_Control
+ * @brief Detects drive wheel slip and backs off drive output to keep traction.
+ *
+ * The powered wheels' speed, worked out from the integrated motor encoders, is
+ * compared against the ground speed measured by the vertical tracking wheel.
+ * When the powered wheels spin faster than the ground is moving, the drive
+ * output is reduced through the power governor until the slip drops back under
+ * the limit. This applies to both driver control and lemlib motions.
+ */
+class Traction_Control {
+    public:
+
+        /**
+         * @brief Starts the traction control task if it is not already running.
+         */
+        static void Start();
+
+        /**
+         * @brief Stops the traction control task and releases the drive output.
+         */
+        static void Stop();
+
+        /**
+         * @brief Returns the most recent slip ratio of the drive wheels.
+         *
+         * @return 0 when the wheels grip, approaching 1 when they spin freely.
+         */
+        static double GetSlip();
+
+        /**
+         * @brief Returns the drive scale currently requested by traction control.
+         */
+        static double GetScale();
+
+    private:
+        static void TractionTask(void *param);
+        static void Update();
+
+        static pros::Task *tractionTask;
+        static double slip;
+        static double scale;
+        static double lastGroundDistance;
+        static uint64_t lastSampleTime;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef TUNING_CONSOLE_H
+#define TUNING_CONSOLE_H
+
+#include "api.h"
+#include "pros/apix.h"
+#include "Command.h"
+
+/**
+ * @class Tuning_Console
+ * @brief Brain screen page for tuning the chassis and arm PIDs without re-uploading.
+ *
+ * The page edits the lateral, angular or arm gains with spinboxes, runs a test
+ * step of the size set on the slider and plots the setpoint against the
+ * measured response. Gains take effect on the next test step and are only
+ * written to the SD card when Save is pressed.
+ *
+ * Chassis steps hold the drivetrain with a command for as long as they run, so
+ * the driver's default command cannot write the drive motors mid-step. The
+ * motion itself is started from the console's sample task, never from the
+ * scheduler, and the chart is fed from an LVGL task so only LVGL touches it.
+ */
+class Tuning_Console {
+    public:
+
+        /**
+         * @brief Controllers that can be tuned.
+         */
+        enum Target {
+            LATERAL = 0,
+            ANGULAR,
+            ARM,
+            TARGET_COUNT
+        };
+
+        /**
+         * @brief Switches the Brain screen to the tuning console, building it on first use.
+         */
+        static void Show();
+
+    private:
+        /**
+         * @brief Holds the drivetrain while a chassis test step is pending or recording.
+         */
+        class StepCommand : public Command {
+            public:
+                StepCommand() : Command(DRIVETRAIN) {}
+                void Initialize() override;
+                bool IsFinished() override;
+                void End(bool interrupted) override;
+        };
+
+        static void Build();
+        static void LoadGains();
+        static void ShowStep();
+        static void RunStep();
+        static void StartMotion();
+        static void SampleTask(void *param);
+        static void ChartTask(void *param);
+
+        static lv_res_t TargetAction(lv_obj_t *btnm, const char *text);
+        static lv_res_t AdjustAction(lv_obj_t *btn);
+        static lv_res_t SliderAction(lv_obj_t *slider);
+        static lv_res_t RunAction(lv_obj_t *btn);
+        static lv_res_t SaveAction(lv_obj_t *btn);
+        static lv_res_t BackAction(lv_obj_t *btn);
+        static void GainChanged(lv_obj_t *spinbox, int32_t value);
+
+        static lv_obj_t *screen;
+        static lv_obj_t *spinboxes[3];
+        static lv_obj_t *slider;
+        static lv_obj_t *stepLabel;
+        static lv_obj_t *statusLabel;
+        static lv_obj_t *chart;
+        static lv_chart_series_t *setpointSeries;
+        static lv_chart_series_t *measuredSeries;
+        static pros::Task *sampleTask;
+        static StepCommand stepCommand;
+        static Target target;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+#ifndef VELOCITY_DRIVE_H
+#define VELOCITY_DRIVE_H
+
+#include "Robot_Config.h"
+
+extern Robot_Config robotDevices;
+
+/**
+ * @class Velocity_Drive
+ * @brief Closed-loop tank drive that turns stick positions into wheel speeds.
+ *
+ * Each side runs a feedforward and PID velocity loop every 10 ms, stepped by
+ * the drivetrain's driver command on the command scheduler, and sends
+ * voltages straight to its motor group, so a given stick position gives the
+ * same speed whatever the battery level or load. Full stick is capped below
+ * free speed so that promise holds on a tired battery. Targets are ramped by an
+ * acceleration limit, and while both sticks are pushed together the heading
+ * is held with the IMU so straight pushes don't drift.
+ */
+class Velocity_Drive {
+    public:
+
+        /**
+         * @brief Switches driver control to the velocity loop.
+         */
+        static void Start();
+
+        /**
+         * @brief Switches the velocity loop off and stops the drive motors.
+         */
+        static void Stop();
+
+        /**
+         * @brief Returns true while the velocity loop owns the drive motors.
+         */
+        static bool IsRunning();
+
+        /**
+         * @brief Runs one step of the velocity loop. Call every 10 ms while running.
+         *
+         * @param left Left stick, from -127 to 127.
+         * @param right Right stick, from -127 to 127.
+         */
+        static void Update(int left, int right);
+
+    private:
+        static void DriveSide(pros::MotorGroup &motors, lemlib::PID &pid, double target, double acceleration);
+
+        static bool running;
+        static double leftTarget;
+        static double rightTarget;
+        static bool holdingHeading;
+        static double heldHeading;
+        static lemlib::PID leftPID;
+        static lemlib::PID rightPID;
+};
+
+#endif
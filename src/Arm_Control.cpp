@@ -1,16 +1,18 @@
 #include "Robot_Config.h"
 #include "Arm_Control.h"
+#include "Telemetry.h"
+#include "Deferred_Log.h"
+#include "Config_Store.h"
+#include "Command_Scheduler.h"
 #include "lemlib/api.hpp"
 
 extern Robot_Config robotDevices;
 
-pros::Task *Arm_Control::armTask = nullptr;
+Arm_Control::MoveCommand Arm_Control::moveCommand;
 int Arm_Control::armTargetPosition = 0;
 
-// PID Constants
-const double kP = 0.0;
-const double kI = 0.0;
-const double kD = 0.0;
+// PID Constants (gains come from the config store)
+const uint32_t armDeadline = 1000;
 const double tolerance = 200.0;
 const double maxPower = 127.0;
 const double minPower = -127.0;
@@ -36,57 +38,59 @@ int Arm_Control::GetPosition() {
     return robotDevices.armRotation.get_position();
 }
 
-void Arm_Control::ArmPID(void *param) {
+void Arm_Control::MoveCommand::Initialize() {
     robotDevices.armMotor1.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
     robotDevices.armMotor2.set_brake_mode(pros::E_MOTOR_BRAKE_HOLD);
 
-    double error = 0.0, lastError = 0.0;
-    double integral = 0.0, derivative = 0.0;
-    double motorPower = 0.0;
+    error = armTargetPosition - GetPosition();
+    lastError = error;
+    integral = 0.0;
+    profile = Loop_Profiler::Register("Arm PID", armDeadline);
+}
 
-    while (true) {
-        double currentPosition = GetPosition();
-        
-        // Emergency reset position condition
-        if (currentPosition < 10000.0) {
-            robotDevices.armRotation.set_position(35800.0);
-        }
+void Arm_Control::MoveCommand::Execute() {
+    Loop_Profiler::Scope timer(profile);
+    const StoredConfig &config = Config_Store::Get();
+    double kP = config.armGains[0], kI = config.armGains[1], kD = config.armGains[2];
+    double currentPosition = GetPosition();
 
-        error = armTargetPosition - currentPosition;
-        integral += error;
-        derivative = error - lastError;
+    // Emergency reset position condition
+    if (currentPosition < 10000.0) {
+        Deferred_Log::Warn("Arm rotation reset from {}", currentPosition);
+        robotDevices.armRotation.set_position(config.armResetPosition);
+    }
 
-        motorPower = (kP * error) + (kI * integral) + (kD * derivative);
-        motorPower = std::clamp(motorPower, minPower, maxPower);
+    lastError = error;
+    error = armTargetPosition - currentPosition;
+    integral += error;
+    double derivative = error - lastError;
 
-        robotDevices.armMotor1.move(motorPower);
-        robotDevices.armMotor2.move(-motorPower);
+    double motorPower = (kP * error) + (kI * integral) + (kD * derivative);
+    motorPower = std::clamp(motorPower, minPower, maxPower);
+    Telemetry::SetArmPID(kP * error, kI * integral, kD * derivative);
 
-        if (fabs(error) <= tolerance) {
-            break;
-        }
+    robotDevices.armMotor1.move(motorPower);
+    robotDevices.armMotor2.move(-motorPower);
+}
 
-        lastError = error;
-        pros::delay(10);
-    }
+bool Arm_Control::MoveCommand::IsFinished() {
+    return fabs(error) <= tolerance;
+}
 
+void Arm_Control::MoveCommand::End(bool interrupted) {
     robotDevices.armMotor1.move(0);
     robotDevices.armMotor2.move(0);
-
 }
 
-
 void Arm_Control::StartArmPID(int target) {
-    if (armTask == nullptr) {
-        armTargetPosition = target;
-        armTask = new pros::Task(ArmPID, nullptr, "Arm PID Task");
-    }
+    armTargetPosition = target;
+    Command_Scheduler::Schedule(&moveCommand);
 }
 
 void Arm_Control::StopArmPID() {
-    if (armTask != nullptr) {
-        armTask->remove();
-        delete armTask;
-        armTask = nullptr;
-    }
+    Command_Scheduler::Cancel(&moveCommand);
+}
+
+bool Arm_Control::IsArmPIDRunning() {
+    return moveCommand.IsScheduled();
 }
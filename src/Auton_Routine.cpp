@@ -0,0 +1,80 @@
+#include "Auton_Routine.h"
+
+/**
+ * @brief Transforms a point and heading.
+ *
+ * A clockwise quarter turn takes (x, y) to (y, -x) and adds 90 degrees to
+ * the heading.
+ */
+lemlib::Pose Field_Transform::Apply(const lemlib::Pose &pose) const {
+    float x = mirror ? -pose.x : pose.x;
+    float y = pose.y;
+
+    for (int turn = 0; turn < (quarterTurns & 3); turn++) {
+        float rotated = y;
+        y = -x;
+        x = rotated;
+    }
+
+    return lemlib::Pose(x, y, ApplyHeading(pose.theta));
+}
+
+/**
+ * @brief Transforms a heading, in degrees.
+ */
+float Field_Transform::ApplyHeading(float heading) const {
+    float transformed = mirror ? -heading : heading;
+    return transformed + 90.0f * (quarterTurns & 3);
+}
+
+/**
+ * @brief Transforms a swing's locked side, which swaps under reflection.
+ */
+lemlib::DriveSide Field_Transform::ApplySide(lemlib::DriveSide side) const {
+    if (!mirror) return side;
+    return side == lemlib::DriveSide::LEFT ? lemlib::DriveSide::RIGHT : lemlib::DriveSide::LEFT;
+}
+
+/**
+ * @brief Transforms a forced turn direction, which reverses under reflection.
+ */
+lemlib::AngularDirection Field_Transform::ApplyDirection(lemlib::AngularDirection direction) const {
+    if (!mirror) return direction;
+
+    switch (direction) {
+        case lemlib::AngularDirection::CW_CLOCKWISE: return lemlib::AngularDirection::CCW_COUNTERCLOCKWISE;
+        case lemlib::AngularDirection::CCW_COUNTERCLOCKWISE: return lemlib::AngularDirection::CW_CLOCKWISE;
+        default: return direction;
+    }
+}
+
+/**
+ * @brief Transforms every pose, heading, side and direction of a step.
+ *
+ * Path points are transformed separately, since steps only refer to them.
+ */
+Auton_Step Field_Transform::Apply(const Auton_Step &step) const {
+    Auton_Step transformed = step;
+
+    switch (step.type) {
+        case Auton_Step::SET_POSE:
+        case Auton_Step::MOVE_TO_POINT:
+        case Auton_Step::MOVE_TO_POSE: {
+            lemlib::Pose pose = Apply(lemlib::Pose(step.x, step.y, step.theta));
+            transformed.x = pose.x;
+            transformed.y = pose.y;
+            transformed.theta = pose.theta;
+            break;
+        }
+        case Auton_Step::TURN_TO_HEADING:
+        case Auton_Step::SWING_TO_HEADING:
+            transformed.theta = ApplyHeading(step.theta);
+            break;
+        default:
+            break;
+    }
+
+    transformed.side = ApplySide(step.side);
+    transformed.direction = ApplyDirection(step.direction);
+    return transformed;
+}
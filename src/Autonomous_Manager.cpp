@@ -1,4 +1,9 @@
 #include "Autonomous_Manager.h"
+#include "Robot_Config.h"
+#include "Field_Map.h"
+#include "Command_Scheduler.h"
+
+extern Robot_Config robotDevices;
 
 // Class constructor
 
@@ -10,51 +15,312 @@
  * 
  * @param robot Reference to the Robot object that this manager will control.
  */
-Autonomous_Manager::Autonomous_Manager(Robot& robot) : robot(robot) {}
+Autonomous_Manager::Autonomous_Manager(Robot& robot)
+    : robot(robot), stepCoroutine(*this), preparedRoutine(NO_ROUTINE) {}
 
 
-// Autonomous routines
+// Match Routine Constants
+const float pathMinSpeed = 60;
+const float pathExitRange = 4;
+const int routinePollPeriod = 10;
 
+/**
+ * @brief Path points for the match routine's FOLLOW_PATH steps, in field inches.
+ */
+static const lemlib::Pose matchPath[] = {
+    lemlib::Pose(-24, 40), lemlib::Pose(-20, 48), lemlib::Pose(-8, 50)
+};
 
 /**
- * @brief Executes the autonomous routine for the Blue Alliance, left side.
- * 
- * This function contains the sequence of actions that the robotDevices should perform 
- * during the autonomous period when positioned on the left side of the Blue Alliance field.
+ * @brief The match routine, written for the Red Alliance left side.
+ */
+static const Auton_Step matchSteps[] = {
+    Auton_Step::SetPose(-60, 24, 270),
+    // Back into the mobile goal, firing the clamp just before it seats so the piston closes as it arrives
+    Auton_Step::MoveToPoint(-26, 24, 1500, false).Async(),
+    Auton_Step::AwaitDistance(30),
+    Auton_Step::Action(Auton_Step::CLAMP, 1),
+    Auton_Step::AwaitMotion(),
+    Auton_Step::Action(Auton_Step::INTAKE, 127),
+    // Sweep the ring stack in front of the goal
+    Auton_Step::TurnToHeading(0, 800),
+    Auton_Step::FollowPath(0, 3, 1500),
+    Auton_Step::Wait(500),
+    // Swing round and finish touching the ladder, stopping the intake on the way
+    Auton_Step::SwingToHeading(180, lemlib::DriveSide::RIGHT, 1000),
+    Auton_Step::MoveToPoint(-12, 12, 1500).Async(),
+    Auton_Step::AwaitDistance(12),
+    Auton_Step::Action(Auton_Step::INTAKE, 0),
+    Auton_Step::AwaitMotion()
+};
+
+static const Auton_Routine matchRoutine = {
+    matchSteps, sizeof(matchSteps) / sizeof(matchSteps[0]), matchPath, sizeof(matchPath) / sizeof(matchPath[0])
+};
+
+/**
+ * @brief Transform from the routine as written to each starting position, indexed by Routine.
+ */
+static const Field_Transform matchTransforms[] = {
+    {false, 2},  // BLUE_LEFT: half turn about the field centre
+    {true, 0},   // BLUE_RIGHT: reflected across the centre line
+    {false, 0},  // RED_LEFT: as written
+    {true, 2}    // RED_RIGHT: reflected across the x axis
+};
+
+/**
+ * @brief Transforms the match routine for a starting position ahead of time.
+ *
+ * Every pose, heading, swing side, turn direction and path point is
+ * transformed once here; running the routine only reads the prepared copy.
+ * The prepared motion targets are also handed to the field map.
  */
-void Autonomous_Manager::BlueMatchLeft() {
+void Autonomous_Manager::Prepare(int routine) {
+    if (routine == preparedRoutine || routine < BLUE_LEFT || routine > RED_RIGHT) return;
+
+    const Field_Transform &transform = matchTransforms[routine];
+
+    preparedSteps.clear();
+    for (int i = 0; i < matchRoutine.stepCount; i++) {
+        preparedSteps.push_back(transform.Apply(matchRoutine.steps[i]));
+    }
+
+    preparedPath.clear();
+    for (int i = 0; i < matchRoutine.pathCount; i++) {
+        preparedPath.push_back(transform.Apply(matchRoutine.path[i]));
+    }
 
+    // Draw where the routine will drive
+    std::vector<lemlib::Pose> targets;
+    for (const Auton_Step &step : preparedSteps) {
+        if (step.type == Auton_Step::SET_POSE || step.type == Auton_Step::MOVE_TO_POINT ||
+            step.type == Auton_Step::MOVE_TO_POSE) {
+            targets.push_back(lemlib::Pose(step.x, step.y, step.theta));
+        } else if (step.type == Auton_Step::FOLLOW_PATH) {
+            targets.insert(targets.end(), preparedPath.begin() + step.pathStart,
+                           preparedPath.begin() + step.pathStart + step.pathLength);
+        }
+    }
+    Field_Map::SetPath(targets.data(), targets.size());
 
+    preparedRoutine = routine;
 }
 
 /**
- * @brief Executes the autonomous routine for the Blue Alliance, right side.
- * 
- * This function is intended to contain the sequence of actions for the Blue Alliance's 
- * right side during the autonomous period. Currently empty and needs to be implemented.
+ * @brief Returns true for steps that start a lemlib motion.
  */
-void Autonomous_Manager::BlueMatchRight() {
+static bool IsMotion(const Auton_Step &step) {
+    switch (step.type) {
+        case Auton_Step::MOVE_TO_POINT:
+        case Auton_Step::MOVE_TO_POSE:
+        case Auton_Step::TURN_TO_HEADING:
+        case Auton_Step::SWING_TO_HEADING:
+        case Auton_Step::FOLLOW_PATH:
+            return true;
+        default:
+            return false;
+    }
+}
 
+/**
+ * @brief Carries out a step that is not a motion.
+ *
+ * These only set outputs or schedule commands, so they run straight from the
+ * step coroutine. Motions go through RequestMotion, and the waiting steps are
+ * handled by the coroutine itself.
+ */
+void Autonomous_Manager::StartStep(const Auton_Step &step) {
+    switch (step.type) {
+        case Auton_Step::SET_POSE:
+            robotDevices.chassis.setPose(step.x, step.y, step.theta);
+            break;
+        case Auton_Step::INTAKE:
+            if (step.value > 0) {
+                robot.intake.Intake(step.value);
+            } else if (step.value < 0) {
+                robot.intake.Outtake(-step.value);
+            } else {
+                robot.intake.StopIntake();
+            }
+            break;
+        case Auton_Step::CLAMP:
+            if (step.value) {
+                robot.mogoClamp.Clamp();
+            } else {
+                robot.mogoClamp.Unclamp();
+            }
+            break;
+        case Auton_Step::ARM:
+            robot.lift.StartArmPID(step.value);
+            break;
+        case Auton_Step::DOINKER:
+            if (step.value) {
+                robot.doinker.Lower();
+            } else {
+                robot.doinker.Raise();
+            }
+            break;
+        default:
+            break;
+    }
 }
 
 /**
- * @brief Executes the autonomous routine for the Red Alliance, left side.
- * 
- * This function is intended to contain the sequence of actions for the Red Alliance's 
- * left side during the autonomous period. Currently empty and needs to be implemented.
+ * @brief Asks the motion task to start a motion step, or one point of a FOLLOW_PATH step.
+ *
+ * Returns straight away; MotionStarted turns true once lemlib has the motion.
+ */
+void Autonomous_Manager::RequestMotion(const Auton_Step &step, int pathIndex) {
+    requestedStep = &step;
+    requestedPathIndex = pathIndex;
+    motionStarted = false;
+    motionRequested = true;
+    motionTask->notify();
+}
+
+/**
+ * @brief Asks the motion task to cancel every motion, including one it has not started yet.
  */
-void Autonomous_Manager::RedMatchLeft() {
+void Autonomous_Manager::RequestCancel() {
+    motionRequested = false;
+    cancelRequested = true;
+    if (motionTask != nullptr) motionTask->notify();
+}
 
+/**
+ * @brief Starts a motion step asynchronously.
+ */
+void Autonomous_Manager::StartMotion(const Auton_Step &step) {
+    lemlib::Chassis &chassis = robotDevices.chassis;
+
+    switch (step.type) {
+        case Auton_Step::MOVE_TO_POINT: {
+            lemlib::MoveToPointParams params;
+            params.forwards = step.forwards;
+            chassis.moveToPoint(step.x, step.y, step.timeout, params, true);
+            break;
+        }
+        case Auton_Step::MOVE_TO_POSE: {
+            lemlib::MoveToPoseParams params;
+            params.forwards = step.forwards;
+            chassis.moveToPose(step.x, step.y, step.theta, step.timeout, params, true);
+            break;
+        }
+        case Auton_Step::TURN_TO_HEADING: {
+            lemlib::TurnToHeadingParams params;
+            params.direction = step.direction;
+            chassis.turnToHeading(step.theta, step.timeout, params, true);
+            break;
+        }
+        case Auton_Step::SWING_TO_HEADING: {
+            lemlib::SwingToHeadingParams params;
+            params.direction = step.direction;
+            chassis.swingToHeading(step.theta, step.side, step.timeout, params, true);
+            break;
+        }
+        default:
+            break;
+    }
 }
 
 /**
- * @brief Executes the autonomous routine for the Red Alliance, right side.
- * 
- * This function is intended to contain the sequence of actions for the Red Alliance's 
- * right side during the autonomous period. Currently empty and needs to be implemented.
+ * @brief Starts the motion to one point of a FOLLOW_PATH step.
+ *
+ * The robot only slows down for the last point; the others are left early
+ * so the chain of motions flows through them.
  */
-void Autonomous_Manager::RedMatchRight() {
-    
+void Autonomous_Manager::StartPathPoint(const Auton_Step &step, int index) {
+    const lemlib::Pose &point = preparedPath[step.pathStart + index];
+    lemlib::MoveToPointParams params;
+    params.forwards = step.forwards;
+    if (index + 1 < step.pathLength) {
+        params.minSpeed = pathMinSpeed;
+        params.earlyExitRange = pathExitRange;
+    }
+    robotDevices.chassis.moveToPoint(point.x, point.y, step.timeout, params, true);
+}
+
+/**
+ * @brief Starts and cancels motions for the step coroutine.
+ *
+ * The pose is taken just before each motion starts, so Traveled measures
+ * from where the motion began rather than from when the coroutine began
+ * waiting. RequestCancel withdraws any request not yet taken, and a cancel
+ * is handled before the next request, so a motion asked for just before the
+ * routine was stopped is never started.
+ */
+void Autonomous_Manager::MotionTask(void *param) {
+    Autonomous_Manager &manager = *static_cast<Autonomous_Manager *>(param);
+
+    while (true) {
+        pros::Task::notify_take(true, TIMEOUT_MAX);
+
+        if (manager.cancelRequested.exchange(false)) {
+            robotDevices.chassis.cancelAllMotions();
+        }
+
+        if (manager.motionRequested.exchange(false)) {
+            const Auton_Step &step = *manager.requestedStep;
+            manager.motionStartPose = robotDevices.chassis.getPose();
+            if (step.type == Auton_Step::FOLLOW_PATH) {
+                manager.StartPathPoint(step, manager.requestedPathIndex);
+            } else {
+                manager.StartMotion(step);
+            }
+            manager.motionStarted = true;
+        }
+    }
+}
+
+/**
+ * @brief Runs the prepared steps in order.
+ *
+ * lemlib only runs one motion at a time, so every motion first waits for
+ * the one before it. Each motion is started by the motion task; the
+ * coroutine waits until it has started, then takes its start pose for
+ * Traveled. Steps between an asynchronous motion and the next wait run while
+ * the robot is still driving.
+ */
+bool Autonomous_Manager::Step_Coroutine::Resume() {
+    CO_BEGIN
+
+    for (stepIndex = 0; stepIndex < (int)manager.preparedSteps.size(); stepIndex++) {
+        if (IsMotion(Current())) CO_AWAIT(MotionDone());
+
+        if (Current().type == Auton_Step::FOLLOW_PATH) {
+            for (pathIndex = 0; pathIndex < Current().pathLength; pathIndex++) {
+                if (pathIndex > 0) CO_AWAIT(MotionDone());
+                manager.RequestMotion(Current(), pathIndex);
+                CO_AWAIT(manager.MotionStarted());
+                motionPose = manager.motionStartPose;
+            }
+        } else if (IsMotion(Current())) {
+            manager.RequestMotion(Current(), 0);
+            CO_AWAIT(manager.MotionStarted());
+            motionPose = manager.motionStartPose;
+        } else {
+            manager.StartStep(Current());
+        }
+
+        if (IsMotion(Current()) && !Current().async) {
+            CO_AWAIT(MotionDone());
+        } else if (Current().type == Auton_Step::WAIT) {
+            CO_AWAIT(Elapsed(Current().timeout));
+        } else if (Current().type == Auton_Step::AWAIT_MOTION) {
+            CO_AWAIT(MotionDone());
+        } else if (Current().type == Auton_Step::AWAIT_DISTANCE) {
+            CO_AWAIT(MotionDone() || Traveled(Current().value));
+        }
+    }
+
+    CO_END
+}
+
+/**
+ * @brief Stops the robot if the routine was cut short.
+ */
+void Autonomous_Manager::Step_Coroutine::End(bool interrupted) {
+    if (interrupted) manager.RequestCancel();
 }
 
 /**
@@ -65,4 +331,41 @@ void Autonomous_Manager::RedMatchRight() {
  */
 void Autonomous_Manager::Skills() {
 
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Executes the routine with the given Routine number.
+ *
+ * @param routine The routine to run. NO_ROUTINE and unknown values do nothing.
+ */
+void Autonomous_Manager::Run(int routine) {
+    switch (routine) {
+        case BLUE_LEFT:
+        case BLUE_RIGHT:
+        case RED_LEFT:
+        case RED_RIGHT:
+            Prepare(routine);
+            if (motionTask == nullptr) {
+                motionTask = new pros::Task(MotionTask, this, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT,
+                                            "Auton Motion Task");
+            }
+            Command_Scheduler::Schedule(&stepCoroutine);
+            while (stepCoroutine.IsScheduled()) {
+                pros::delay(routinePollPeriod);
+            }
+            break;
+        case SKILLS:
+            Skills();
+            break;
+    }
+}
+
+/**
+ * @brief Stops a running match routine and any motion it started.
+ *
+ * The routine runs on the scheduler task, so it outlives the autonomous
+ * task when the competition switch ends autonomous early.
+ */
+void Autonomous_Manager::Stop() {
+    Command_Scheduler::Cancel(&stepCoroutine);
+}
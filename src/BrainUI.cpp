@@ -1,36 +1,73 @@
 #include "pros/apix.h"
 #include "Brain_UI.h"
+#include "Image_Asset.h"
+#include "Autonomous_Manager.h"
+#include "Config_Store.h"
+#include "Tuning_Console.h"
+#include "Match_Recorder.h"
+#include "Loop_Profiler.h"
 
-// Imports the image data for the field and logo images.
-#include "High_Stakes_Field_Image.h"
+// Imports the image data for the logo image; the field image is packed on the SD card
 #include "Logo_Image.h"
 
 using namespace pros;
 
 // Holds the selected autonomous mode.
-int Brain_UI::selectedAuton;
+int Brain_UI::selectedAuton = Autonomous_Manager::NO_ROUTINE;
 
-// Initialize autonomous buttons and their corresponding labels.
+// Screens are built on first use and kept for the life of the program
+lv_obj_t * Brain_UI::selectorScreen = nullptr;
+lv_obj_t * Brain_UI::matchScreen = nullptr;
+
+// Initialize autonomous buttons and the selected autonomous label.
 lv_obj_t * leftSideBlueButton;
 lv_obj_t * rightSideBlueButton;
 lv_obj_t * leftSideRedButton;
 lv_obj_t * rightSideRedButton;
-lv_obj_t * leftSideBlueButtonLabel;
-lv_obj_t * rightSideBlueButtonLabel;
-lv_obj_t * leftSideRedButtonLabel;
-lv_obj_t * rightSideRedButtonLabel;
 lv_obj_t * selectedAutonLabel;
+lv_obj_t * replayLabel;
 
 // Initialize the LVGL styles for each button
 lv_style_t redAutoButtonStyle;
 lv_style_t blueAutoButtonStyle;
 lv_style_t buttonPressedStyle;
 
-// Initialize image object
-LV_IMG_DECLARE(HighStakesFieldImage);
+// Initialize image objects; copy usd/field_image.bin from the repository to the SD card
+const char * fieldImagePath = "/usd/field_image.bin";
+lv_img_dsc_t HighStakesFieldImage;
+bool fieldImageLoaded = false;
+bool fieldImageDecoded = false;
 LV_IMG_DECLARE(LogoImage);
 
 
+/**
+ * @brief Returns the alliance a routine plays for; skills and macros have none, so ring sorting stays off.
+ */
+static Config_Store::Alliance GetAutonAlliance(int routine) {
+    switch (routine) {
+        case Autonomous_Manager::RED_LEFT:
+        case Autonomous_Manager::RED_RIGHT: return Config_Store::RED;
+        case Autonomous_Manager::BLUE_LEFT:
+        case Autonomous_Manager::BLUE_RIGHT: return Config_Store::BLUE;
+        default: return Config_Store::NO_ALLIANCE;
+    }
+}
+
+/**
+ * @brief Returns the label text for an autonomous routine.
+ */
+static const char * GetAutonName(int routine) {
+    switch (routine) {
+        case Autonomous_Manager::BLUE_LEFT: return "Blue Alliance Left";
+        case Autonomous_Manager::BLUE_RIGHT: return "Blue Alliance Right";
+        case Autonomous_Manager::RED_LEFT: return "Red Alliance Left";
+        case Autonomous_Manager::RED_RIGHT: return "Red Alliance Right";
+        case Autonomous_Manager::SKILLS: return "Skills";
+        case Autonomous_Manager::MACRO: return "Driver Macro";
+        default: return "Selected Auton: None";
+    }
+}
+
 /**
  * @brief Callback function for handling button presses.
  * 
@@ -43,51 +80,140 @@ LV_IMG_DECLARE(LogoImage);
  */
 lv_res_t Brain_UI::btn_click_action(lv_obj_t * btn) {
     uint8_t id = lv_obj_get_free_num(btn);
-	
-    // Set the autonomous mode and update label based on the button ID
-    switch(id) {
-        case 0:
-            lv_label_set_text(selectedAutonLabel, "Blue Alliance Left");
-            selectedAuton = 1;
-            break;
-        case 1:
-            lv_label_set_text(selectedAutonLabel, "Blue Alliance Right");
-            selectedAuton = 0;
-            break;
-        case 2:
-            lv_label_set_text(selectedAutonLabel, "Red Alliance Left");
-            selectedAuton = 2;
-            break;
-        case 3:
-            lv_label_set_text(selectedAutonLabel, "Red Alliance Right");
-            selectedAuton = 3;
-            break;
+
+    // Button IDs are Autonomous_Manager routines, so the selection maps straight through
+    selectedAuton = id;
+    lv_label_set_text(selectedAutonLabel, GetAutonName(id));
+
+    // Remember the selection across brain reboots
+    StoredConfig &config = Config_Store::Get();
+    config.selectedAuton = id;
+    config.alliance = GetAutonAlliance(id);
+    Config_Store::Save();
+    return LV_RES_OK;
+}
+
+/**
+ * @brief Opens the tuning console from the selector screen.
+ */
+lv_res_t Brain_UI::tune_click_action(lv_obj_t * btn) {
+    Tuning_Console::Show();
+    return LV_RES_OK;
+}
+
+/**
+ * @brief Opens the loop profiler report from the selector screen.
+ */
+lv_res_t Brain_UI::loops_click_action(lv_obj_t * btn) {
+    Loop_Profiler::ShowReport();
+    return LV_RES_OK;
+}
+
+/**
+ * @brief Turns replay of /usd/replay.bin on or off from the selector screen.
+ *
+ * Replay has to be asked for here every time; it is refused while the robot
+ * is connected to a field or competition switch.
+ */
+lv_res_t Brain_UI::replay_click_action(lv_obj_t * btn) {
+    if (Match_Recorder::IsReplaying()) {
+        Match_Recorder::StopReplay();
+        lv_label_set_text(replayLabel, "Replay");
+    } else if (Match_Recorder::StartReplay()) {
+        lv_label_set_text(replayLabel, "Replay ON");
+    } else {
+        lv_label_set_text(replayLabel, "No Replay");
     }
     return LV_RES_OK;
 }
 
 /**
- * @brief Displays the match image (logo) on the screen.
+ * @brief Returns the field image, loading it from the SD card the first time it is needed.
+ *
+ * The card is only read once; without the image, the selector and the field
+ * map draw on a plain background.
+ *
+ * @return The decoded field image, or nullptr if it could not be loaded.
+ */
+const lv_img_dsc_t * Brain_UI::GetFieldImage() {
+    if (!fieldImageLoaded) {
+        fieldImageLoaded = true;
+        fieldImageDecoded = pros::usd::is_installed() && Image_Asset::Load(fieldImagePath, HighStakesFieldImage);
+    }
+    return fieldImageDecoded ? &HighStakesFieldImage : nullptr;
+}
+
+/**
+ * @brief Switches the Brain screen to the match (logo) image.
  */
 void Brain_UI::DisplayMatchImage() {
+    if (matchScreen == nullptr) {
+        BuildMatchImage();
+    }
+    lv_scr_load(matchScreen);
+}
+
+/**
+ * @brief Displays the autonomous selector UI on the brain screen.
+ */
+void Brain_UI::DisplayAutonSelectorUI() {
+    if (selectorScreen == nullptr) {
+        BuildAutonSelector();
+    }
+    lv_scr_load(selectorScreen);
+}
+
+/**
+ * @brief Creates the match screen with the logo centered on it.
+ */
+void Brain_UI::BuildMatchImage() {
+    matchScreen = lv_obj_create(NULL, NULL);
+
     // Draw the logo image
-    lv_obj_t * img2 = lv_img_create(lv_scr_act(), NULL);
+    lv_obj_t * img2 = lv_img_create(matchScreen, NULL);
     lv_img_set_src(img2, &LogoImage);  // Use the LogoImage descriptor here
     lv_obj_align(img2, NULL, LV_ALIGN_CENTER, 0, 0);  // Center the image on the screen
 }
 
 /**
- * @brief Displays the autonomous selector UI on the brain screen.
+ * @brief Creates one autonomous selection button on the selector screen.
+ *
+ * @param id The button ID passed to btn_click_action.
+ * @param style The released style of the button.
+ * @param align Where to place the button on the screen.
+ * @param x Horizontal offset from the alignment point.
+ * @param y Vertical offset from the alignment point.
+ * @param text The button's label.
+ * @return The created button.
  */
-void Brain_UI::DisplayAutonSelectorUI() {
+lv_obj_t * Brain_UI::CreateAutonButton(int id, lv_style_t * style, lv_align_t align, lv_coord_t x, lv_coord_t y,
+                                       const char * text) {
+    lv_obj_t * button = lv_btn_create(selectorScreen, NULL);
+    lv_obj_set_free_num(button, id);
+    lv_btn_set_action(button, LV_BTN_ACTION_CLICK, btn_click_action);
+    lv_btn_set_style(button, LV_BTN_STYLE_REL, style);
+    lv_btn_set_style(button, LV_BTN_STYLE_PR, &buttonPressedStyle);
+    lv_obj_set_size(button, 100, 100);
+    lv_obj_align(button, NULL, align, x, y);
 
-    // Set default autonomous mode
-    selectedAuton = 4;
+    lv_obj_t * label = lv_label_create(button, NULL);
+    lv_label_set_text(label, text);
+    return button;
+}
+
+/**
+ * @brief Creates the selector screen with the field image, buttons and selection label.
+ */
+void Brain_UI::BuildAutonSelector() {
+    selectorScreen = lv_obj_create(NULL, NULL);
 
     // Draw the field image on the brain screen
-    lv_obj_t * img = lv_img_create(lv_scr_act(), NULL);
-    lv_img_set_src(img, &HighStakesFieldImage);  // Use the HighStakesFieldImage descriptor here
-    lv_obj_align(img, NULL, LV_ALIGN_CENTER, 0, 0);  // Center the image
+    const lv_img_dsc_t * fieldImage = GetFieldImage();
+    if (fieldImage != nullptr) {
+        lv_obj_t * img = lv_img_create(selectorScreen, NULL);
+        lv_img_set_src(img, fieldImage);  // Use the HighStakesFieldImage descriptor here
+        lv_obj_align(img, NULL, LV_ALIGN_CENTER, 0, 0);  // Center the image
+    }
 
     // Set red side auto button appearance
     lv_style_copy(&redAutoButtonStyle, &lv_style_plain);
@@ -110,52 +236,51 @@ void Brain_UI::DisplayAutonSelectorUI() {
     buttonPressedStyle.body.radius = 0;
     buttonPressedStyle.text.color = LV_COLOR_MAKE(255, 255, 255);
 
-    // Create Left Blue Auto button
-    leftSideBlueButton = lv_btn_create(lv_scr_act(), NULL);
-    lv_obj_set_free_num(leftSideBlueButton, 0);
-    lv_btn_set_action(leftSideBlueButton, LV_BTN_ACTION_CLICK, btn_click_action);
-    lv_btn_set_style(leftSideBlueButton, LV_BTN_STYLE_REL, &blueAutoButtonStyle);
-    lv_btn_set_style(leftSideBlueButton, LV_BTN_STYLE_PR, &buttonPressedStyle);
-    lv_obj_set_size(leftSideBlueButton, 100, 100);
-    lv_obj_align(leftSideBlueButton, NULL, LV_ALIGN_IN_TOP_LEFT, 10, 10);
-    leftSideBlueButtonLabel = lv_label_create(leftSideBlueButton, NULL);
-    lv_label_set_text(leftSideBlueButtonLabel, "Left Blue");
-
-    // Create Right Blue Auto button
-    rightSideBlueButton = lv_btn_create(lv_scr_act(), NULL);
-    lv_obj_set_free_num(rightSideBlueButton, 1);
-    lv_btn_set_action(rightSideBlueButton, LV_BTN_ACTION_CLICK, btn_click_action);
-    lv_btn_set_style(rightSideBlueButton, LV_BTN_STYLE_REL, &blueAutoButtonStyle);
-    lv_btn_set_style(rightSideBlueButton, LV_BTN_STYLE_PR, &buttonPressedStyle);
-    lv_obj_set_size(rightSideBlueButton, 100, 100);
-    lv_obj_align(rightSideBlueButton, NULL, LV_ALIGN_IN_BOTTOM_LEFT, 10, -10);
-    rightSideBlueButtonLabel = lv_label_create(rightSideBlueButton, NULL);
-    lv_label_set_text(rightSideBlueButtonLabel, "Right Blue");
-
-    // Create Left Red Auto button
-    leftSideRedButton = lv_btn_create(lv_scr_act(), NULL);
-    lv_obj_set_free_num(leftSideRedButton, 2);
-    lv_btn_set_action(leftSideRedButton, LV_BTN_ACTION_CLICK, btn_click_action);
-    lv_btn_set_style(leftSideRedButton, LV_BTN_STYLE_REL, &redAutoButtonStyle);
-    lv_btn_set_style(leftSideRedButton, LV_BTN_STYLE_PR, &buttonPressedStyle);
-    lv_obj_set_size(leftSideRedButton, 100, 100);
-    lv_obj_align(leftSideRedButton, NULL, LV_ALIGN_IN_BOTTOM_RIGHT, -10, -10);
-    leftSideRedButtonLabel = lv_label_create(leftSideRedButton, NULL);
-    lv_label_set_text(leftSideRedButtonLabel, "Left Red");
-
-    // Create Right Red Auto button
-    rightSideRedButton = lv_btn_create(lv_scr_act(), NULL);
-    lv_obj_set_free_num(rightSideRedButton, 3);
-    lv_btn_set_action(rightSideRedButton, LV_BTN_ACTION_CLICK, btn_click_action);
-    lv_btn_set_style(rightSideRedButton, LV_BTN_STYLE_REL, &redAutoButtonStyle);
-    lv_btn_set_style(rightSideRedButton, LV_BTN_STYLE_PR, &buttonPressedStyle);
-    lv_obj_set_size(rightSideRedButton, 100, 100);
-    lv_obj_align(rightSideRedButton, NULL, LV_ALIGN_IN_TOP_RIGHT, -10, 10);
-    rightSideRedButtonLabel = lv_label_create(rightSideRedButton, NULL);
-    lv_label_set_text(rightSideRedButtonLabel, "Right Red");
-
-    // Create selectedAutonLabel
-    selectedAutonLabel = lv_label_create(lv_scr_act(), NULL);
-    lv_label_set_text(selectedAutonLabel, "Selected Auton: None");
+    // Create the four autonomous buttons in the corners of the field
+    leftSideBlueButton = CreateAutonButton(Autonomous_Manager::BLUE_LEFT, &blueAutoButtonStyle,
+                                           LV_ALIGN_IN_TOP_LEFT, 10, 10, "Left Blue");
+    rightSideBlueButton = CreateAutonButton(Autonomous_Manager::BLUE_RIGHT, &blueAutoButtonStyle,
+                                            LV_ALIGN_IN_BOTTOM_LEFT, 10, -10, "Right Blue");
+    leftSideRedButton = CreateAutonButton(Autonomous_Manager::RED_LEFT, &redAutoButtonStyle,
+                                          LV_ALIGN_IN_BOTTOM_RIGHT, -10, -10, "Left Red");
+    rightSideRedButton = CreateAutonButton(Autonomous_Manager::RED_RIGHT, &redAutoButtonStyle,
+                                           LV_ALIGN_IN_TOP_RIGHT, -10, 10, "Right Red");
+
+    // Create the button that opens the tuning console
+    lv_obj_t * tuneButton = lv_btn_create(selectorScreen, NULL);
+    lv_btn_set_action(tuneButton, LV_BTN_ACTION_CLICK, tune_click_action);
+    lv_obj_set_size(tuneButton, 80, 40);
+    lv_obj_align(tuneButton, NULL, LV_ALIGN_IN_TOP_MID, 0, 10);
+    lv_obj_t * tuneLabel = lv_label_create(tuneButton, NULL);
+    lv_label_set_text(tuneLabel, "Tune");
+
+    // Create the button that selects playback of a recorded driver macro
+    lv_obj_t * macroButton = lv_btn_create(selectorScreen, NULL);
+    lv_obj_set_free_num(macroButton, Autonomous_Manager::MACRO);
+    lv_btn_set_action(macroButton, LV_BTN_ACTION_CLICK, btn_click_action);
+    lv_obj_set_size(macroButton, 80, 40);
+    lv_obj_align(macroButton, NULL, LV_ALIGN_IN_TOP_MID, 0, 60);
+    lv_obj_t * macroLabel = lv_label_create(macroButton, NULL);
+    lv_label_set_text(macroLabel, "Macro");
+
+    // Create the button that plays a recorded match log back instead of the controller
+    lv_obj_t * replayButton = lv_btn_create(selectorScreen, NULL);
+    lv_btn_set_action(replayButton, LV_BTN_ACTION_CLICK, replay_click_action);
+    lv_obj_set_size(replayButton, 80, 40);
+    lv_obj_align(replayButton, NULL, LV_ALIGN_IN_TOP_MID, 0, 110);
+    replayLabel = lv_label_create(replayButton, NULL);
+    lv_label_set_text(replayLabel, Match_Recorder::IsReplaying() ? "Replay ON" : "Replay");
+
+    // Create the button that opens the loop profiler report
+    lv_obj_t * loopsButton = lv_btn_create(selectorScreen, NULL);
+    lv_btn_set_action(loopsButton, LV_BTN_ACTION_CLICK, loops_click_action);
+    lv_obj_set_size(loopsButton, 80, 40);
+    lv_obj_align(loopsButton, NULL, LV_ALIGN_IN_TOP_MID, 0, 160);
+    lv_obj_t * loopsLabel = lv_label_create(loopsButton, NULL);
+    lv_label_set_text(loopsLabel, "Loops");
+
+    // Create selectedAutonLabel showing the selection loaded from the config store
+    selectedAutonLabel = lv_label_create(selectorScreen, NULL);
+    lv_label_set_text(selectedAutonLabel, GetAutonName(selectedAuton));
     lv_obj_align(selectedAutonLabel, NULL, LV_ALIGN_IN_BOTTOM_MID, 0, -20);
 }
@@ -0,0 +1,232 @@
+#include "Command_Scheduler.h"
+#include "Loop_Profiler.h"
+#include "Deferred_Log.h"
+
+// Scheduler Constants
+const int maxRequests = 16;
+const int schedulerPeriod = 10;
+
+pros::Task *Command_Scheduler::schedulerTask = nullptr;
+pros::Mutex Command_Scheduler::requestMutex;
+Command_Scheduler::Request Command_Scheduler::requests[maxRequests];
+int Command_Scheduler::requestCount = 0;
+Command *Command_Scheduler::running[maxRunning];
+int Command_Scheduler::runningCount = 0;
+Command *Command_Scheduler::defaults[subsystemCount] = {};
+Command *Command_Scheduler::pendingDefaults[subsystemCount] = {};
+void (*Command_Scheduler::periodic)() = nullptr;
+void (*Command_Scheduler::pendingPeriodic)() = nullptr;
+
+/**
+ * @brief Starts the scheduler task if it is not already running.
+ */
+void Command_Scheduler::Start() {
+    if (schedulerTask == nullptr) {
+        schedulerTask = new pros::Task(SchedulerTask, nullptr, "Command Scheduler Task");
+    }
+}
+
+/**
+ * @brief Stops the scheduler task. Running commands are left as they are.
+ */
+void Command_Scheduler::Stop() {
+    if (schedulerTask != nullptr) {
+        schedulerTask->remove();
+        delete schedulerTask;
+        schedulerTask = nullptr;
+    }
+}
+
+/**
+ * @brief Asks for a command to start on the next cycle.
+ */
+void Command_Scheduler::Schedule(Command *command) {
+    requestMutex.take();
+    if (command->state.load() != Command::PENDING) {
+        if (requestCount < maxRequests) {
+            // A running command stays RUNNING; the request only matters if a queued cancel ends it first
+            requests[requestCount++] = {command, false};
+            if (command->state.load() == Command::IDLE) command->state = Command::PENDING;
+        } else {
+            Deferred_Log::Warn("Command request queue full");
+        }
+    }
+    requestMutex.give();
+}
+
+/**
+ * @brief Asks for a command to be ended on the next cycle, as if interrupted.
+ */
+void Command_Scheduler::Cancel(Command *command) {
+    requestMutex.take();
+    if (requestCount < maxRequests) {
+        requests[requestCount++] = {command, true};
+    } else {
+        Deferred_Log::Warn("Command request queue full");
+    }
+    requestMutex.give();
+}
+
+/**
+ * @brief Sets the command that runs whenever nothing else requires a subsystem.
+ */
+void Command_Scheduler::SetDefaultCommand(Subsystem subsystem, Command *command) {
+    requestMutex.take();
+    for (int i = 0; i < subsystemCount; i++) {
+        if (subsystem == 1 << i) pendingDefaults[i] = command;
+    }
+    requestMutex.give();
+}
+
+/**
+ * @brief Removes every default command, ending any that are running.
+ */
+void Command_Scheduler::ClearDefaultCommands() {
+    requestMutex.take();
+    for (int i = 0; i < subsystemCount; i++) {
+        pendingDefaults[i] = nullptr;
+    }
+    requestMutex.give();
+}
+
+/**
+ * @brief Sets a function run at the start of every cycle, before any command.
+ */
+void Command_Scheduler::SetPeriodic(void (*periodic)()) {
+    requestMutex.take();
+    pendingPeriodic = periodic;
+    requestMutex.give();
+}
+
+/**
+ * @brief Starts a command, interrupting the commands holding its subsystems.
+ *
+ * @return False if an uninterruptible command holds one of its subsystems.
+ */
+bool Command_Scheduler::Start(Command *command) {
+    if (command->state.load() == Command::RUNNING) return true;
+
+    uint8_t required = command->GetRequirements();
+    for (int i = 0; i < runningCount; i++) {
+        if ((running[i]->GetRequirements() & required) && !running[i]->IsInterruptible()) {
+            command->state = Command::IDLE;
+            return false;
+        }
+    }
+
+    for (int i = runningCount - 1; i >= 0; i--) {
+        if (running[i]->GetRequirements() & required) End(i, true);
+    }
+
+    if (runningCount >= maxRunning) {
+        command->state = Command::IDLE;
+        return false;
+    }
+
+    running[runningCount++] = command;
+    command->state = Command::RUNNING;
+    command->Initialize();
+    return true;
+}
+
+/**
+ * @brief Removes a running command and calls its End hook.
+ */
+void Command_Scheduler::End(int index, bool interrupted) {
+    Command *command = running[index];
+    for (int i = index; i < runningCount - 1; i++) {
+        running[i] = running[i + 1];
+    }
+    runningCount--;
+
+    command->state = Command::IDLE;
+    command->End(interrupted);
+}
+
+/**
+ * @brief Takes the queued requests and settings, then applies them in order.
+ */
+void Command_Scheduler::ApplyRequests() {
+    Request taken[maxRequests];
+    Command *newDefaults[subsystemCount];
+
+    requestMutex.take();
+    int count = requestCount;
+    for (int i = 0; i < count; i++) taken[i] = requests[i];
+    requestCount = 0;
+    for (int i = 0; i < subsystemCount; i++) newDefaults[i] = pendingDefaults[i];
+    periodic = pendingPeriodic;
+    requestMutex.give();
+
+    // End default commands that have been replaced or removed
+    for (int s = 0; s < subsystemCount; s++) {
+        if (defaults[s] == newDefaults[s]) continue;
+        for (int i = 0; i < runningCount; i++) {
+            if (running[i] == defaults[s]) {
+                End(i, true);
+                break;
+            }
+        }
+        defaults[s] = newDefaults[s];
+    }
+
+    for (int r = 0; r < count; r++) {
+        if (!taken[r].cancel) {
+            Start(taken[r].command);
+            continue;
+        }
+
+        for (int i = 0; i < runningCount; i++) {
+            if (running[i] == taken[r].command) {
+                End(i, true);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Runs one scheduler cycle.
+ */
+void Command_Scheduler::RunCycle() {
+    ApplyRequests();
+    if (periodic != nullptr) periodic();
+
+    for (int i = 0; i < runningCount;) {
+        Command *command = running[i];
+        command->Execute();
+        if (command->IsFinished()) {
+            End(i, false);
+        } else {
+            i++;
+        }
+    }
+
+    // Hand free subsystems to their default commands
+    uint8_t used = 0;
+    for (int i = 0; i < runningCount; i++) used |= running[i]->GetRequirements();
+
+    for (int s = 0; s < subsystemCount; s++) {
+        Command *command = defaults[s];
+        if (command == nullptr || command->state.load() == Command::RUNNING) continue;
+        if (command->GetRequirements() & used) continue;
+
+        if (Start(command)) used |= command->GetRequirements();
+    }
+}
+
+/**
+ * @brief Background task that runs a scheduler cycle every scheduler period.
+ */
+void Command_Scheduler::SchedulerTask(void *param) {
+    Loop_Profiler::Profile *loopProfile = Loop_Profiler::Register("Command Scheduler", 5000);
+    uint32_t now = pros::millis();
+
+    while (true) {
+        {
+            Loop_Profiler::Scope timer(loopProfile);
+            RunCycle();
+        }
+        pros::Task::delay_until(&now, schedulerPeriod);
+    }
+}
@@ -0,0 +1,192 @@
+#include "Config_Store.h"
+#include "Robot_Config.h"
+#include "Autonomous_Manager.h"
+#include "Checksum.h"
+#include "Deferred_Log.h"
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+extern Robot_Config robotDevices;
+
+// Store Constants
+const char *slotPaths[2] = {"/usd/config_a.bin", "/usd/config_b.bin"};
+const char configMagic[8] = {'6', '7', '4', '1', 'C', 'F', 'G', '\0'};
+const uint16_t configVersion = 1;
+
+// Stick positions of the stored drive curve points
+const float curveInputs[StoredConfig::curvePoints] = {0, 16, 48, 88, 127};
+
+/**
+ * @brief Header written in front of the configuration in each slot.
+ */
+#pragma pack(push, 1)
+struct ConfigHeader {
+    char magic[8];
+    uint16_t version;
+    uint16_t size;
+    uint32_t sequence;
+};
+#pragma pack(pop)
+
+StoredConfig Config_Store::config;
+uint32_t Config_Store::sequence = 0;
+int Config_Store::lastSlot = 1;
+
+/**
+ * @brief Fills the configuration with the values the code was written with.
+ */
+void Config_Store::SetDefaults() {
+    const lemlib::ControllerSettings &lateral = robotDevices.lateralController;
+    const lemlib::ControllerSettings &angular = robotDevices.angularController;
+
+    config = StoredConfig{};
+    config.selectedAuton = Autonomous_Manager::NO_ROUTINE;
+    config.alliance = NO_ALLIANCE;
+    config.armGains[0] = config.armGains[1] = config.armGains[2] = 0.0f;
+    config.lateralGains[0] = lateral.kP;
+    config.lateralGains[1] = lateral.kI;
+    config.lateralGains[2] = lateral.kD;
+    config.angularGains[0] = angular.kP;
+    config.angularGains[1] = angular.kI;
+    config.angularGains[2] = angular.kD;
+    config.armResetPosition = 35800;
+    for (int i = 0; i < StoredConfig::curvePoints; i++) {
+        config.throttleCurve[i] = curveInputs[i];
+        config.steerCurve[i] = curveInputs[i];
+    }
+    config.redRingHue = 10.0f;
+    config.blueRingHue = 215.0f;
+    config.ringHueTolerance = 30.0f;
+}
+
+/**
+ * @brief Reads one slot, checking its magic, size and checksum.
+ *
+ * A slot written by an older version holds a shorter record; its fields are
+ * copied over the defaults and the newer fields keep their default values.
+ *
+ * @return True if the slot held a valid configuration.
+ */
+bool Config_Store::ReadSlot(int slot, StoredConfig &loaded, uint32_t &loadedSequence) {
+    FILE *file = fopen(slotPaths[slot], "rb");
+    if (file == nullptr) return false;
+
+    uint8_t data[sizeof(ConfigHeader) + sizeof(StoredConfig) + sizeof(uint16_t)];
+    size_t length = fread(data, 1, sizeof(data), file);
+    fclose(file);
+
+    ConfigHeader header;
+    if (length < sizeof(header)) return false;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.magic, configMagic, sizeof(configMagic)) != 0) return false;
+    if (header.size > sizeof(StoredConfig) || length != sizeof(header) + header.size + sizeof(uint16_t)) return false;
+
+    uint16_t stored;
+    std::memcpy(&stored, data + sizeof(header) + header.size, sizeof(stored));
+    if (Crc16(data, sizeof(header) + header.size) != stored) return false;
+
+    loaded = config;
+    std::memcpy(&loaded, data + sizeof(header), header.size);
+    loadedSequence = header.sequence;
+    return true;
+}
+
+/**
+ * @brief Loads the newest valid configuration from the SD card.
+ */
+bool Config_Store::Load() {
+    SetDefaults();
+    if (!pros::usd::is_installed()) return false;
+
+    bool found = false;
+    for (int slot = 0; slot < 2; slot++) {
+        StoredConfig loaded;
+        uint32_t loadedSequence;
+        if (!ReadSlot(slot, loaded, loadedSequence)) continue;
+
+        if (!found || loadedSequence > sequence) {
+            config = loaded;
+            sequence = loadedSequence;
+            lastSlot = slot;
+            found = true;
+        }
+    }
+
+    if (!found) Deferred_Log::Info("No saved configuration, using defaults");
+    return found;
+}
+
+/**
+ * @brief Writes the configuration to whichever slot does not hold the newest copy.
+ */
+bool Config_Store::Save() {
+    if (!pros::usd::is_installed()) return false;
+
+    uint8_t data[sizeof(ConfigHeader) + sizeof(StoredConfig) + sizeof(uint16_t)];
+    ConfigHeader header;
+    std::memcpy(header.magic, configMagic, sizeof(configMagic));
+    header.version = configVersion;
+    header.size = sizeof(StoredConfig);
+    header.sequence = sequence + 1;
+
+    std::memcpy(data, &header, sizeof(header));
+    std::memcpy(data + sizeof(header), &config, sizeof(config));
+    uint16_t crc = Crc16(data, sizeof(header) + sizeof(config));
+    std::memcpy(data + sizeof(header) + sizeof(config), &crc, sizeof(crc));
+
+    int slot = 1 - lastSlot;
+    FILE *file = fopen(slotPaths[slot], "wb");
+    if (file == nullptr) return false;
+
+    bool written = fwrite(data, 1, sizeof(data), file) == sizeof(data);
+    written = fclose(file) == 0 && written;
+    if (!written) {
+        Deferred_Log::Warn("Failed to save configuration");
+        return false;
+    }
+
+    sequence = header.sequence;
+    lastSlot = slot;
+    return true;
+}
+
+/**
+ * @brief Returns the configuration. Call Save after changing it.
+ */
+StoredConfig &Config_Store::Get() {
+    return config;
+}
+
+/**
+ * @brief Replaces a lemlib PID with one using new gains.
+ *
+ * lemlib keeps its gains in const members, so the controller is rebuilt in
+ * place instead of assigned. Its integral and previous error start from zero.
+ */
+static void RebuildPID(lemlib::PID &pid, const float gains[3], float windupRange) {
+    pid.~PID();
+    new (&pid) lemlib::PID(gains[0], gains[1], gains[2], windupRange);
+}
+
+/**
+ * @brief Hands the stored chassis gains to lemlib's PID controllers.
+ *
+ * Only call this while no lemlib motion is running.
+ */
+void Config_Store::ApplyChassisGains() {
+    RebuildPID(robotDevices.chassis.lateralPID, config.lateralGains, robotDevices.lateralController.windupRange);
+    RebuildPID(robotDevices.chassis.angularPID, config.angularGains, robotDevices.angularController.windupRange);
+}
+
+/**
+ * @brief Rebuilds the driver curve tables from the stored curve points.
+ *
+ * The points are joined with a monotone spline and sampled into the lookup
+ * tables once here, so the driver loop never evaluates the spline itself.
+ */
+void Config_Store::ApplyDriveCurves() {
+    robotDevices.throttleCurve.Build(Spline_Shape<StoredConfig::curvePoints>(curveInputs, config.throttleCurve));
+    robotDevices.steerCurve.Build(Spline_Shape<StoredConfig::curvePoints>(curveInputs, config.steerCurve));
+}
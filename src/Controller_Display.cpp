@@ -0,0 +1,154 @@
+#include "Controller_Display.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+// Display Constants
+const uint32_t displayPeriod = 50;
+const int rumbleQueueSize = 4;
+const int rumbleLength = 8;
+
+pros::Controller *Controller_Display::controller = nullptr;
+pros::Task *Controller_Display::displayTask = nullptr;
+
+// Text wanted on each row and text last accepted by the controller
+static char wanted[Controller_Display::rows][Controller_Display::columns + 1];
+static char sent[Controller_Display::rows][Controller_Display::columns + 1];
+static int nextRow = 0;
+
+// Rumble patterns waiting to be sent, oldest first
+static char rumbles[rumbleQueueSize][rumbleLength + 1];
+static int rumbleHead = 0;
+static int rumbleCount = 0;
+
+static pros::Mutex gridMutex;
+
+/**
+ * @brief Starts the display task for a controller.
+ */
+void Controller_Display::Start(pros::Controller &controller) {
+    Controller_Display::controller = &controller;
+
+    for (int row = 0; row < rows; row++) {
+        std::memset(wanted[row], ' ', columns);
+        wanted[row][columns] = '\0';
+        // Force every row out once, whatever the controller was showing before
+        sent[row][0] = '\0';
+    }
+
+    if (displayTask == nullptr) {
+        displayTask = new pros::Task(DisplayTask, nullptr, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT,
+                                     "Controller Display Task");
+    }
+}
+
+/**
+ * @brief Sets the text of one row, padded or cut to the row width.
+ *
+ * Padding with spaces means a shorter message clears whatever the row
+ * showed before it.
+ */
+void Controller_Display::Print(int row, const char *format, ...) {
+    if (row < 0 || row >= rows) return;
+
+    char text[columns + 1];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+
+    if (length < 0) length = 0;
+    if (length < columns) std::memset(text + length, ' ', columns - length);
+    text[columns] = '\0';
+
+    gridMutex.take();
+    std::memcpy(wanted[row], text, sizeof(text));
+    gridMutex.give();
+}
+
+/**
+ * @brief Queues a rumble pattern of '.', '-' and ' ' characters.
+ */
+bool Controller_Display::Rumble(const char *pattern) {
+    gridMutex.take();
+    bool queued = rumbleCount < rumbleQueueSize;
+    if (queued) {
+        char *slot = rumbles[(rumbleHead + rumbleCount) % rumbleQueueSize];
+        std::strncpy(slot, pattern, rumbleLength);
+        slot[rumbleLength] = '\0';
+        rumbleCount++;
+    }
+    gridMutex.give();
+    return queued;
+}
+
+/**
+ * @brief Sends the oldest queued rumble, or else the next row that changed.
+ *
+ * Rows are checked round-robin from the one after the last row sent, so a row
+ * that changes every period cannot starve the others. A send the controller
+ * rejects is left pending and retried next period.
+ *
+ * @return True if something was sent.
+ */
+bool Controller_Display::SendNext() {
+    char pattern[rumbleLength + 1];
+    char text[columns + 1];
+    int row = -1;
+
+    gridMutex.take();
+    bool rumble = rumbleCount > 0;
+    if (rumble) {
+        std::memcpy(pattern, rumbles[rumbleHead], sizeof(pattern));
+    } else {
+        for (int i = 0; i < rows; i++) {
+            int candidate = (nextRow + i) % rows;
+            if (std::strcmp(wanted[candidate], sent[candidate]) != 0) {
+                row = candidate;
+                std::memcpy(text, wanted[row], sizeof(text));
+                break;
+            }
+        }
+    }
+    gridMutex.give();
+
+    // Talk to the controller outside the lock so callers never wait on it
+    if (rumble) {
+        if (controller->rumble(pattern) == PROS_ERR) return false;
+
+        gridMutex.take();
+        rumbleHead = (rumbleHead + 1) % rumbleQueueSize;
+        rumbleCount--;
+        gridMutex.give();
+        return true;
+    }
+
+    if (row < 0) return false;
+    if (controller->set_text(row, 0, text) == PROS_ERR) return false;
+
+    std::memcpy(sent[row], text, sizeof(text));
+    nextRow = (row + 1) % rows;
+    return true;
+}
+
+/**
+ * @brief Sends at most one update per display period.
+ *
+ * When the controller reconnects its screen is blank, so every row is marked
+ * as unsent.
+ */
+void Controller_Display::DisplayTask(void *param) {
+    uint32_t now = pros::millis();
+    bool connected = false;
+
+    while (true) {
+        bool nowConnected = controller->is_connected();
+        if (nowConnected && !connected) {
+            for (int row = 0; row < rows; row++) sent[row][0] = '\0';
+        }
+        connected = nowConnected;
+
+        if (connected) SendNext();
+        pros::Task::delay_until(&now, displayPeriod);
+    }
+}
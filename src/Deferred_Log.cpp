@@ -0,0 +1,146 @@
+#include "Deferred_Log.h"
+#include "Byte_Ring.h"
+#include <cstdio>
+
+// Queue Constants
+const uint32_t queueCapacity = 128;
+const uint32_t queueMask = queueCapacity - 1;
+const uint32_t outputCapacity = 4096;
+const int drainPeriod = 20;
+
+static_assert((queueCapacity & queueMask) == 0, "Deferred_Log queue capacity must be a power of two");
+
+pros::Task *Deferred_Log::drainTask = nullptr;
+lemlib::Level Deferred_Log::lowestLevel = lemlib::Level::INFO;
+std::atomic<uint32_t> Deferred_Log::enqueuePosition{0};
+uint32_t Deferred_Log::dequeuePosition = 0;
+std::atomic<uint32_t> Deferred_Log::droppedMessages{0};
+
+// Formatted lines waiting to be written to the terminal in one batch
+static Byte_Ring<outputCapacity> output;
+
+/**
+ * @brief Writes the staged output lines to the terminal.
+ */
+static void FlushOutput() {
+    if (output.Drain([](const uint8_t *data, uint32_t size) { fwrite(data, 1, size, stdout); }) > 0) {
+        fflush(stdout);
+    }
+}
+
+// Level names, indexed by lemlib::Level
+static const char *levelNames[] = {"INFO", "DEBUG", "WARN", "ERROR", "FATAL"};
+
+/**
+ * @brief Fixed queue of entries, each stamped with the position it is next valid for.
+ */
+struct Deferred_Log::Queue {
+    Queue() {
+        for (uint32_t i = 0; i < queueCapacity; i++) entries[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    Entry entries[queueCapacity];
+};
+
+Deferred_Log::Queue Deferred_Log::queue;
+
+/**
+ * @brief Starts the background formatting task.
+ */
+void Deferred_Log::Start() {
+    if (drainTask == nullptr) {
+        drainTask = new pros::Task(DrainTask, nullptr, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT,
+                                   "Deferred Log Task");
+    }
+}
+
+/**
+ * @brief Sets the lowest level that will be queued.
+ */
+void Deferred_Log::SetLowestLevel(lemlib::Level level) {
+    lowestLevel = level;
+}
+
+/**
+ * @brief Returns how many messages were dropped because the queue was full.
+ */
+uint32_t Deferred_Log::GetDroppedMessages() {
+    return droppedMessages.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Claims the next free queue entry for a producer.
+ *
+ * Any number of tasks may log at once. Each one claims an entry by advancing
+ * the enqueue position with a compare-and-swap, so no producer ever blocks.
+ * When the consumer has not yet released the entry the message is dropped.
+ *
+ * @return The claimed entry, or nullptr if the queue is full.
+ */
+Deferred_Log::Entry *Deferred_Log::Reserve() {
+    uint32_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+    while (true) {
+        Entry *entry = &queue.entries[position & queueMask];
+        int32_t difference = entry->sequence.load(std::memory_order_acquire) - position;
+
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                return entry;
+            }
+        } else if (difference < 0) {
+            droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Hands a filled entry over to the consumer.
+ */
+void Deferred_Log::Publish(Entry *entry) {
+    uint32_t sequence = entry->sequence.load(std::memory_order_relaxed);
+    entry->sequence.store(sequence + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Formats and prints the oldest published message.
+ *
+ * The message is formatted into a stack buffer, so even the consumer only
+ * allocates if a single line outgrows it, and then staged in the output ring
+ * so the terminal sees one write per drain period.
+ *
+ * @return True if a message was printed.
+ */
+bool Deferred_Log::Drain() {
+    Entry &entry = queue.entries[dequeuePosition & queueMask];
+    if (entry.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+        return false;
+    }
+
+    fmt::memory_buffer line;
+    fmt::format_to(std::back_inserter(line), "[{}] {}: ", entry.time, levelNames[static_cast<int>(entry.level)]);
+    entry.formatter(entry, line);
+    line.push_back('\n');
+
+    entry.sequence.store(dequeuePosition + queueCapacity, std::memory_order_release);
+    dequeuePosition++;
+
+    if (output.Size() + line.size() > outputCapacity) {
+        FlushOutput();
+    }
+    output.Write(line.data(), line.size());
+    return true;
+}
+
+/**
+ * @brief Formats every queued message, writes them out, then sleeps until the next drain period.
+ */
+void Deferred_Log::DrainTask(void *param) {
+    while (true) {
+        while (Drain());
+        FlushOutput();
+        pros::delay(drainPeriod);
+    }
+}
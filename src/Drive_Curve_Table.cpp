@@ -0,0 +1,31 @@
+#include "Drive_Curve_Table.h"
+#include <cmath>
+
+/**
+ * @brief Evaluates lemlib's exponential curve.
+ *
+ * Matches lemlib::ExpoDriveCurve: zero inside the deadband, then an
+ * exponential that starts at minOutput and reaches 127 at full stick.
+ */
+float Expo_Shape::operator()(float input) const {
+    if (std::fabs(input) <= deadband) return 0.0f;
+
+    float sign = input < 0.0f ? -1.0f : 1.0f;
+    float g = std::fabs(input) - deadband;
+    float g127 = 127.0f - deadband;
+    float i = std::pow(gain, g - 127.0f) * g * sign;
+    float i127 = std::pow(gain, g127 - 127.0f) * g127;
+    return (127.0f - minOutput) / 127.0f * i * 127.0f / i127 + minOutput * sign;
+}
+
+/**
+ * @brief Shapes an input, interpolating between table entries.
+ */
+float Drive_Curve_Table::curve(float input) {
+    float position = Clamp(input) + tableOffset;
+    int index = static_cast<int>(position);
+    if (index >= tableSize - 1) return table[tableSize - 1];
+
+    float fraction = position - index;
+    return table[index] + (table[index + 1] - table[index]) * fraction;
+}
@@ -0,0 +1,358 @@
+#include "Robot_Config.h"
+#include "Driver_Macro.h"
+#include "Deferred_Log.h"
+#include "File_Index.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+extern Robot_Config robotDevices;
+
+// Macro Constants
+const char macroMagic[8] = {'6', '7', '4', '1', 'M', 'A', 'C', '\0'};
+const uint16_t macroVersion = 1;
+const uint32_t keyframePeriod = 200;
+const uint32_t writerPeriod = 100;
+const int flushEvery = 5;
+const uint32_t playbackPeriod = 10;
+const double timingGain = 0.05;
+const double minRate = 0.5;
+const double maxRate = 1.5;
+const double minSegment = 0.5;
+const double headingGain = 2.0;
+
+pros::Task *Driver_Macro::writerTask = nullptr;
+FILE *Driver_Macro::macroFile = nullptr;
+Byte_Ring<4096> Driver_Macro::frameRing;
+std::atomic<bool> Driver_Macro::recording{false};
+std::atomic<bool> Driver_Macro::stopRequested{false};
+std::atomic<bool> Driver_Macro::writerRunning{false};
+ControllerSnapshot Driver_Macro::lastInput{};
+uint32_t Driver_Macro::lastFrameTime = 0;
+uint32_t Driver_Macro::lastKeyframeTime = 0;
+bool Driver_Macro::started = false;
+uint32_t Driver_Macro::droppedFrames = 0;
+
+/**
+ * @brief Opens a new /usd/macro_NNN.bin and starts recording.
+ *
+ * Refused while the writer of the previous recording is still closing its file.
+ */
+bool Driver_Macro::StartRecording() {
+    if (recording || writerRunning || !pros::usd::is_installed()) return false;
+
+    macroFile = File_Index::OpenNext("macro", ".bin", "wb");
+    if (macroFile == nullptr) return false;
+
+    fwrite(macroMagic, sizeof(macroMagic), 1, macroFile);
+    fwrite(&macroVersion, sizeof(macroVersion), 1, macroFile);
+
+    // The previous writer has returned, so only its Task object is left
+    delete writerTask;
+
+    frameRing.Reset();
+    started = false;
+    droppedFrames = 0;
+    stopRequested = false;
+    writerRunning = true;
+    recording = true;
+    writerTask = new pros::Task(WriterTask, nullptr, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT,
+                                "Driver Macro Task");
+    Deferred_Log::Info("Recording driver macro");
+    return true;
+}
+
+/**
+ * @brief Stops recording.
+ *
+ * Called from driver control on the scheduler task, so it only asks the
+ * writer task to stop; the writer writes out what is still buffered, closes
+ * the file and returns on its own.
+ */
+void Driver_Macro::StopRecording() {
+    if (!recording) return;
+
+    recording = false;
+    stopRequested = true;
+}
+
+/**
+ * @brief Returns true while a macro is being recorded.
+ */
+bool Driver_Macro::IsRecording() {
+    return recording;
+}
+
+/**
+ * @brief Appends an unsigned varint to a buffer.
+ *
+ * @return The number of bytes written, at most five.
+ */
+static uint32_t WriteVarint(uint8_t *out, uint32_t value) {
+    uint32_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    out[size++] = value;
+    return size;
+}
+
+/**
+ * @brief Converts a value to a clamped int16 in hundredths.
+ */
+static int16_t ToHundredths(double value) {
+    return static_cast<int16_t>(std::clamp(std::round(value * 100.0), -32768.0, 32767.0));
+}
+
+/**
+ * @brief Records one driver control iteration.
+ *
+ * Iterations where nothing changed and no keyframe is due write nothing;
+ * their time is carried into the next frame's time delta.
+ */
+void Driver_Macro::Record(const ControllerSnapshot &input) {
+    if (!recording) return;
+
+    uint32_t now = pros::millis();
+    if (!started) {
+        lastInput = ControllerSnapshot{};
+        lastFrameTime = now;
+    }
+
+    uint8_t mask = 0;
+    for (int channel = 0; channel < 4; channel++) {
+        if (input.analog[channel] != lastInput.analog[channel]) mask |= 1 << channel;
+    }
+    if (input.buttons != lastInput.buttons) mask |= BUTTONS;
+    if (!started || now - lastKeyframeTime >= keyframePeriod) mask |= POSE;
+    if (mask == 0) return;
+
+    uint8_t frame[1 + 5 + 4 + sizeof(uint16_t) + 3 * sizeof(int16_t)];
+    uint32_t size = 0;
+    frame[size++] = mask;
+    size += WriteVarint(frame + size, now - lastFrameTime);
+
+    for (int channel = 0; channel < 4; channel++) {
+        if (mask & (1 << channel)) {
+            // Wrapping difference, so any change fits in one byte
+            frame[size++] = static_cast<uint8_t>(input.analog[channel] - lastInput.analog[channel]);
+        }
+    }
+    if (mask & BUTTONS) {
+        uint16_t changed = input.buttons ^ lastInput.buttons;
+        std::memcpy(frame + size, &changed, sizeof(changed));
+        size += sizeof(changed);
+    }
+    if (mask & POSE) {
+        lemlib::Pose pose = robotDevices.chassis.getPose();
+        int16_t packed[3] = {ToHundredths(pose.x), ToHundredths(pose.y),
+                             ToHundredths(std::remainder(pose.theta, 360.0))};
+        std::memcpy(frame + size, packed, sizeof(packed));
+        size += sizeof(packed);
+    }
+
+    // Frames are deltas from the last frame written, so a frame the full ring
+    // refuses must not move that state on: the next frame then carries the
+    // whole change since the last written one, and a stall loses timing
+    // detail but never corrupts the inputs that follow
+    if (!frameRing.Write(frame, size)) {
+        if (!droppedFrames++) Deferred_Log::Warn("Driver macro buffer full; merging frames until the card catches up");
+        return;
+    }
+
+    if (mask & POSE) lastKeyframeTime = now;
+    lastInput = input;
+    lastFrameTime = now;
+    started = true;
+}
+
+/**
+ * @brief Writes recorded frames to the SD card until recording stops, then closes the file.
+ */
+void Driver_Macro::WriterTask(void *param) {
+    int iteration = 0;
+    uint32_t now = pros::millis();
+
+    while (!stopRequested) {
+        frameRing.Drain([](const uint8_t *data, uint32_t size) { fwrite(data, 1, size, macroFile); });
+        if (++iteration % flushEvery == 0) {
+            fflush(macroFile);
+        }
+
+        pros::Task::delay_until(&now, writerPeriod);
+    }
+
+    // Record no longer writes to the ring, so this drain gets the last frames
+    frameRing.Drain([](const uint8_t *data, uint32_t size) { fwrite(data, 1, size, macroFile); });
+    fclose(macroFile);
+    macroFile = nullptr;
+    writerRunning = false;
+}
+
+/**
+ * @brief Reads and decodes a macro file.
+ *
+ * Frame and keyframe times are relative to the first frame. A truncated last
+ * frame, as left by a recording cut off by a power loss, is ignored.
+ *
+ * @return False if the file was missing or not a macro.
+ */
+bool Driver_Macro::Load(const char *path, std::vector<Frame> &frames, std::vector<Keyframe> &keyframes) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) return false;
+
+    std::vector<uint8_t> data;
+    uint8_t chunk[512];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + read);
+    }
+    fclose(file);
+
+    uint16_t version;
+    size_t headerSize = sizeof(macroMagic) + sizeof(version);
+    if (data.size() < headerSize || std::memcmp(data.data(), macroMagic, sizeof(macroMagic)) != 0) return false;
+    std::memcpy(&version, data.data() + sizeof(macroMagic), sizeof(version));
+    if (version != macroVersion) return false;
+
+    ControllerSnapshot input{};
+    uint32_t time = 0;
+    size_t position = headerSize;
+
+    while (position < data.size()) {
+        uint8_t mask = data[position++];
+
+        uint32_t delta = 0;
+        int shift = 0;
+        while (position < data.size() && shift < 35) {
+            uint8_t byte = data[position++];
+            delta |= (byte & 0x7F) << shift;
+            shift += 7;
+            if ((byte & 0x80) == 0) break;
+        }
+        time += delta;
+
+        size_t needed = __builtin_popcount(mask & ANALOG);
+        if (mask & BUTTONS) needed += sizeof(uint16_t);
+        if (mask & POSE) needed += 3 * sizeof(int16_t);
+        if (data.size() - position < needed) break;
+
+        for (int channel = 0; channel < 4; channel++) {
+            if (mask & (1 << channel)) {
+                input.analog[channel] = static_cast<int8_t>(input.analog[channel] + data[position++]);
+            }
+        }
+        if (mask & BUTTONS) {
+            uint16_t changed;
+            std::memcpy(&changed, data.data() + position, sizeof(changed));
+            input.buttons ^= changed;
+            position += sizeof(changed);
+        }
+        if (mask & POSE) {
+            int16_t packed[3];
+            std::memcpy(packed, data.data() + position, sizeof(packed));
+            keyframes.push_back({time, lemlib::Pose(packed[0] / 100.0f, packed[1] / 100.0f, packed[2] / 100.0f)});
+            position += sizeof(packed);
+        }
+
+        frames.push_back({time, input});
+    }
+
+    return true;
+}
+
+/**
+ * @brief Interpolates the recorded pose at a point in the macro.
+ *
+ * @param index The keyframe at or before the previous lookup; moved forward as time passes.
+ */
+lemlib::Pose Driver_Macro::PoseAt(const std::vector<Keyframe> &keyframes, size_t &index, double time) {
+    while (index + 1 < keyframes.size() && keyframes[index + 1].time <= time) index++;
+    if (index + 1 >= keyframes.size()) return keyframes[index].pose;
+
+    const Keyframe &from = keyframes[index];
+    const Keyframe &to = keyframes[index + 1];
+    float t = std::clamp((time - from.time) / (to.time - from.time), 0.0, 1.0);
+    float theta = from.pose.theta + lemlib::angleError(to.pose.theta, from.pose.theta, false) * t;
+    return lemlib::Pose(from.pose.x + (to.pose.x - from.pose.x) * t, from.pose.y + (to.pose.y - from.pose.y) * t,
+                        theta);
+}
+
+/**
+ * @brief Plays a recorded macro back. Blocks until the macro has finished.
+ *
+ * Odometry is reset to the first keyframe, so the robot must start where the
+ * recording started. Every iteration the robot's pose is compared with the
+ * recorded pose at the current macro time: the distance the robot is behind
+ * along the recorded direction of travel slows the macro clock, and being
+ * ahead speeds it up. While the recorded drive sticks are moving, the heading
+ * error is mixed into the tank sticks.
+ */
+bool Driver_Macro::Play(const char *path, void (*apply)(const ControllerSnapshot &input)) {
+    std::vector<Frame> frames;
+    std::vector<Keyframe> keyframes;
+    if (!Load(path, frames, keyframes)) {
+        Deferred_Log::Warn("No driver macro to play");
+        return false;
+    }
+    if (frames.empty()) return true;
+
+    if (!keyframes.empty()) robotDevices.chassis.setPose(keyframes[0].pose);
+
+    size_t frameIndex = 0;
+    size_t keyIndex = 0;
+    double macroTime = 0.0;
+    uint32_t now = pros::millis();
+
+    while (macroTime <= frames.back().time) {
+        while (frameIndex + 1 < frames.size() && frames[frameIndex + 1].time <= macroTime) frameIndex++;
+        ControllerSnapshot input = frames[frameIndex].input;
+        double rate = 1.0;
+
+        if (keyframes.size() >= 2) {
+            lemlib::Pose recorded = PoseAt(keyframes, keyIndex, macroTime);
+            lemlib::Pose actual = robotDevices.chassis.getPose();
+
+            const Keyframe &from = keyframes[keyIndex];
+            const Keyframe &to = keyframes[std::min(keyIndex + 1, keyframes.size() - 1)];
+            double dx = to.pose.x - from.pose.x;
+            double dy = to.pose.y - from.pose.y;
+            double length = std::hypot(dx, dy);
+            if (length > minSegment) {
+                double behind = ((recorded.x - actual.x) * dx + (recorded.y - actual.y) * dy) / length;
+                rate = std::clamp(1.0 - behind * timingGain, minRate, maxRate);
+            }
+
+            int left = input.analog[pros::E_CONTROLLER_ANALOG_LEFT_Y];
+            int right = input.analog[pros::E_CONTROLLER_ANALOG_RIGHT_Y];
+            if (left != 0 || right != 0) {
+                double correction = headingGain * lemlib::angleError(recorded.theta, actual.theta, false);
+                input.analog[pros::E_CONTROLLER_ANALOG_LEFT_Y] = std::clamp(left + correction, -127.0, 127.0);
+                input.analog[pros::E_CONTROLLER_ANALOG_RIGHT_Y] = std::clamp(right - correction, -127.0, 127.0);
+            }
+        }
+
+        apply(input);
+        pros::Task::delay_until(&now, playbackPeriod);
+        macroTime += playbackPeriod * rate;
+    }
+
+    apply(ControllerSnapshot{});
+    return true;
+}
+
+/**
+ * @brief Plays the newest /usd/macro_NNN.bin back. Blocks until the macro has finished.
+ */
+bool Driver_Macro::PlayLatest(void (*apply)(const ControllerSnapshot &input)) {
+    int index = File_Index::GetLatest("macro");
+    if (index < 0) {
+        Deferred_Log::Warn("No driver macro to play");
+        return false;
+    }
+
+    char path[32];
+    File_Index::FormatPath(path, sizeof(path), "macro", index, ".bin");
+    return Play(path, apply);
+}
@@ -0,0 +1,310 @@
+#include "Field_Map.h"
+#include "Brain_UI.h"
+#include "Robot_Config.h"
+#include "Loop_Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+extern Robot_Config robotDevices;
+
+// Map Constants (pixels / inches / ms)
+const lv_coord_t mapSize = 240;
+const double pixelsPerInch = mapSize / 144.0;
+const double robotSize = 15.0;
+const int maxTrailPoints = 512;
+const int trailSpacing = 2;
+const double moveThreshold = 0.5;
+const double turnThreshold = 1.0;
+const uint32_t mapPeriod = 100;
+
+const lv_color_t backgroundColor = LV_COLOR_MAKE(40, 40, 40);
+const lv_color_t trailColor = LV_COLOR_MAKE(255, 200, 0);
+const lv_color_t pathColor = LV_COLOR_MAKE(0, 255, 120);
+const lv_color_t robotColor = LV_COLOR_MAKE(255, 255, 255);
+const lv_color_t headingColor = LV_COLOR_MAKE(255, 0, 255);
+
+lv_obj_t *Field_Map::mapScreen = nullptr;
+lv_obj_t *Field_Map::canvas = nullptr;
+lv_color_t *Field_Map::buffer = nullptr;
+Loop_Profiler::Profile *Field_Map::loopProfile = nullptr;
+
+// Overlay state, owned by the map task once it is running
+static lv_point_t trail[maxTrailPoints];
+static int trailCount = 0;
+static lv_point_t path[Field_Map::maxPathPoints];
+static int pathCount = 0;
+static lemlib::Pose lastPose(1e6, 1e6, 0);
+static lv_area_t robotBounds = {0, 0, -1, -1};
+static const lv_area_t wholeMap = {0, 0, mapSize - 1, mapSize - 1};
+
+// Requests from other tasks, picked up on the next update
+static pros::Mutex pathMutex;
+static lv_point_t pendingPath[Field_Map::maxPathPoints];
+static int pendingPathCount = -1;
+static bool clearRequested = false;
+
+/**
+ * @brief Converts a field position in inches to a map pixel.
+ *
+ * lemlib's origin is the centre of the field with +Y pointing up the screen.
+ */
+static lv_point_t ToPixel(double x, double y) {
+    return {static_cast<lv_coord_t>(std::lround(mapSize / 2 + x * pixelsPerInch)),
+            static_cast<lv_coord_t>(std::lround(mapSize / 2 - y * pixelsPerInch))};
+}
+
+/**
+ * @brief Grows an area to cover a point. An area with x2 < x1 is empty.
+ */
+static void Include(lv_area_t &area, lv_coord_t x, lv_coord_t y) {
+    if (area.x2 < area.x1) {
+        area = {x, y, x, y};
+        return;
+    }
+    area.x1 = std::min(area.x1, x);
+    area.y1 = std::min(area.y1, y);
+    area.x2 = std::max(area.x2, x);
+    area.y2 = std::max(area.y2, y);
+}
+
+/**
+ * @brief Clips an area to the map, returning false if nothing is left.
+ */
+static bool ClipToMap(lv_area_t &area) {
+    if (area.x2 < area.x1) return false;
+    area.x1 = std::max<lv_coord_t>(area.x1, 0);
+    area.y1 = std::max<lv_coord_t>(area.y1, 0);
+    area.x2 = std::min<lv_coord_t>(area.x2, mapSize - 1);
+    area.y2 = std::min<lv_coord_t>(area.y2, mapSize - 1);
+    return area.x1 <= area.x2 && area.y1 <= area.y2;
+}
+
+/**
+ * @brief Switches the Brain screen to the field map, building it on first use.
+ */
+void Field_Map::Show() {
+    if (mapScreen == nullptr) {
+        buffer = new (std::nothrow) lv_color_t[mapSize * mapSize];
+        if (buffer == nullptr) return;
+
+        mapScreen = lv_obj_create(NULL, NULL);
+        canvas = lv_canvas_create(mapScreen, NULL);
+        lv_canvas_set_buffer(canvas, buffer, mapSize, mapSize, LV_IMG_CF_TRUE_COLOR);
+        lv_obj_align(canvas, NULL, LV_ALIGN_CENTER, 0, 0);
+        Redraw();
+
+        // Updates run as an LVGL task, so the canvas is never written while LVGL is drawing it
+        loopProfile = Loop_Profiler::Register("Field Map", 5000);
+        lv_task_create(MapTask, mapPeriod, LV_TASK_PRIO_LOW, nullptr);
+    }
+
+    lv_scr_load(mapScreen);
+}
+
+/**
+ * @brief Sets the planned path drawn under the robot.
+ */
+void Field_Map::SetPath(const lemlib::Pose *points, int count) {
+    count = std::min(count, maxPathPoints);
+
+    pathMutex.take();
+    for (int i = 0; i < count; i++) {
+        pendingPath[i] = ToPixel(points[i].x, points[i].y);
+    }
+    pendingPathCount = count;
+    pathMutex.give();
+}
+
+/**
+ * @brief Clears the odometry trail.
+ */
+void Field_Map::ClearTrail() {
+    clearRequested = true;
+}
+
+/**
+ * @brief Copies the field image back over an area of the canvas.
+ */
+void Field_Map::RestoreBackground(const lv_area_t &area) {
+    const lv_img_dsc_t *field = Brain_UI::GetFieldImage();
+    lv_coord_t width = area.x2 - area.x1 + 1;
+
+    for (lv_coord_t y = area.y1; y <= area.y2; y++) {
+        lv_color_t *row = buffer + y * mapSize + area.x1;
+        if (field != nullptr && field->header.w == mapSize && field->header.h == mapSize) {
+            const lv_color_t *source = reinterpret_cast<const lv_color_t *>(field->data) + y * mapSize + area.x1;
+            std::memcpy(row, source, width * sizeof(lv_color_t));
+        } else {
+            std::fill(row, row + width, backgroundColor);
+        }
+    }
+}
+
+/**
+ * @brief Draws a line into the canvas buffer, skipping pixels outside the clip area.
+ *
+ * @param bounds Grown to cover every pixel that was drawn.
+ */
+void Field_Map::DrawLine(lv_point_t from, lv_point_t to, lv_color_t color, const lv_area_t &clip, lv_area_t &bounds) {
+    int dx = std::abs(to.x - from.x);
+    int dy = -std::abs(to.y - from.y);
+    int stepX = from.x < to.x ? 1 : -1;
+    int stepY = from.y < to.y ? 1 : -1;
+    int error = dx + dy;
+
+    while (true) {
+        if (from.x >= clip.x1 && from.x <= clip.x2 && from.y >= clip.y1 && from.y <= clip.y2) {
+            buffer[from.y * mapSize + from.x] = color;
+            Include(bounds, from.x, from.y);
+        }
+        if (from.x == to.x && from.y == to.y) break;
+
+        int doubled = 2 * error;
+        if (doubled >= dy) {
+            error += dy;
+            from.x += stepX;
+        }
+        if (doubled <= dx) {
+            error += dx;
+            from.y += stepY;
+        }
+    }
+}
+
+/**
+ * @brief Redraws the path and trail segments that cross an area.
+ */
+void Field_Map::DrawOverlays(const lv_area_t &clip) {
+    lv_area_t unused = {0, 0, -1, -1};
+
+    for (int i = 1; i < pathCount; i++) {
+        DrawLine(path[i - 1], path[i], pathColor, clip, unused);
+    }
+    for (int i = 1; i < trailCount; i++) {
+        DrawLine(trail[i - 1], trail[i], trailColor, clip, unused);
+    }
+}
+
+/**
+ * @brief Draws the robot's footprint and heading.
+ *
+ * lemlib headings are in degrees, clockwise from +Y.
+ *
+ * @param bounds Set to the area covered by the robot.
+ */
+void Field_Map::DrawRobot(const lemlib::Pose &pose, lv_area_t &bounds) {
+    double heading = pose.theta * M_PI / 180.0;
+    double forwardX = std::sin(heading), forwardY = std::cos(heading);
+    double half = robotSize / 2;
+
+    lv_point_t corners[4];
+    const double signs[4][2] = {{1, 1}, {1, -1}, {-1, -1}, {-1, 1}};
+    for (int i = 0; i < 4; i++) {
+        double along = signs[i][0] * half, across = signs[i][1] * half;
+        corners[i] = ToPixel(pose.x + forwardX * along + forwardY * across, pose.y + forwardY * along - forwardX * across);
+    }
+
+    bounds = {0, 0, -1, -1};
+    for (int i = 0; i < 4; i++) {
+        DrawLine(corners[i], corners[(i + 1) % 4], robotColor, wholeMap, bounds);
+    }
+    DrawLine(ToPixel(pose.x, pose.y), ToPixel(pose.x + forwardX * half, pose.y + forwardY * half), headingColor,
+             wholeMap, bounds);
+}
+
+/**
+ * @brief Marks an area of the canvas for LVGL to redraw.
+ */
+void Field_Map::Invalidate(const lv_area_t &area) {
+    lv_area_t screen;
+    lv_obj_get_coords(canvas, &screen);
+
+    lv_area_t dirty = {static_cast<lv_coord_t>(screen.x1 + area.x1), static_cast<lv_coord_t>(screen.y1 + area.y1),
+                       static_cast<lv_coord_t>(screen.x1 + area.x2), static_cast<lv_coord_t>(screen.y1 + area.y2)};
+    lv_inv_area(&dirty);
+}
+
+/**
+ * @brief Repaints the whole map. Only used when the path or trail changes wholesale.
+ */
+void Field_Map::Redraw() {
+    RestoreBackground(wholeMap);
+    DrawOverlays(wholeMap);
+    robotBounds = {0, 0, -1, -1};
+    lastPose = lemlib::Pose(1e6, 1e6, 0);
+    lv_obj_invalidate(canvas);
+}
+
+/**
+ * @brief Moves the robot on the map, touching only the rectangles that changed.
+ */
+void Field_Map::Update() {
+    bool redraw = false;
+
+    pathMutex.take();
+    if (pendingPathCount >= 0) {
+        std::copy(pendingPath, pendingPath + pendingPathCount, path);
+        pathCount = pendingPathCount;
+        pendingPathCount = -1;
+        redraw = true;
+    }
+    pathMutex.give();
+
+    if (clearRequested) {
+        clearRequested = false;
+        trailCount = 0;
+        redraw = true;
+    }
+
+    // Drop the oldest quarter of a full trail; its pixels go with the repaint
+    if (trailCount == maxTrailPoints) {
+        int dropped = maxTrailPoints / 4;
+        std::copy(trail + dropped, trail + trailCount, trail);
+        trailCount -= dropped;
+        redraw = true;
+    }
+
+    if (redraw) Redraw();
+
+    lemlib::Pose pose = robotDevices.chassis.getPose();
+    if (pose.distance(lastPose) * pixelsPerInch < moveThreshold && std::fabs(pose.theta - lastPose.theta) < turnThreshold) {
+        return;
+    }
+    lastPose = pose;
+
+    // Erase the old robot and put back whatever was under it
+    lv_area_t dirty = robotBounds;
+    if (ClipToMap(dirty)) {
+        RestoreBackground(dirty);
+        DrawOverlays(dirty);
+    }
+
+    // Extend the trail once the robot has moved far enough from its last point
+    lv_point_t position = ToPixel(pose.x, pose.y);
+    if (trailCount == 0) {
+        trail[trailCount++] = position;
+    } else {
+        lv_point_t last = trail[trailCount - 1];
+        if (std::abs(position.x - last.x) + std::abs(position.y - last.y) >= trailSpacing) {
+            DrawLine(last, position, trailColor, wholeMap, dirty);
+            trail[trailCount++] = position;
+        }
+    }
+
+    DrawRobot(pose, robotBounds);
+    Include(dirty, robotBounds.x1, robotBounds.y1);
+    Include(dirty, robotBounds.x2, robotBounds.y2);
+    if (ClipToMap(dirty)) Invalidate(dirty);
+}
+
+/**
+ * @brief Updates the map while its screen is showing. Runs as an LVGL task every map period.
+ */
+void Field_Map::MapTask(void *param) {
+    if (lv_scr_act() != mapScreen) return;
+
+    Loop_Profiler::Scope timer(loopProfile);
+    Update();
+}
@@ -0,0 +1,75 @@
+#include "File_Index.h"
+
+// Index Constants
+const int maxIndex = 1000;
+
+/**
+ * @brief Writes the path of a numbered file into a buffer.
+ */
+void File_Index::FormatPath(char *path, size_t size, const char *name, int index, const char *extension) {
+    snprintf(path, size, "/usd/%s_%03d%s", name, index, extension);
+}
+
+/**
+ * @brief Reads the next free number of a name from its counter file.
+ *
+ * @return The stored number, or 0 if there is no counter file yet.
+ */
+int File_Index::ReadCounter(const char *name) {
+    char path[32];
+    snprintf(path, sizeof(path), "/usd/%s_next.txt", name);
+
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) return 0;
+
+    int next = 0;
+    if (fscanf(file, "%d", &next) != 1 || next < 0 || next >= maxIndex) next = 0;
+    fclose(file);
+    return next;
+}
+
+/**
+ * @brief Stores the next free number of a name in its counter file.
+ */
+void File_Index::WriteCounter(const char *name, int next) {
+    char path[32];
+    snprintf(path, sizeof(path), "/usd/%s_next.txt", name);
+
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) return;
+    fprintf(file, "%d\n", next);
+    fclose(file);
+}
+
+/**
+ * @brief Creates the next numbered file of a name.
+ *
+ * The counter is only a hint: if its file already exists, for instance
+ * because the counter file was deleted, the following numbers are tried
+ * until a free one is found. On a card whose counter is right, that is a
+ * single check.
+ */
+FILE *File_Index::OpenNext(const char *name, const char *extension, const char *mode) {
+    char path[32];
+
+    for (int index = ReadCounter(name); index < maxIndex; index++) {
+        FormatPath(path, sizeof(path), name, index, extension);
+        FILE *existing = fopen(path, "r");
+        if (existing != nullptr) {
+            fclose(existing);
+            continue;
+        }
+
+        WriteCounter(name, index + 1);
+        return fopen(path, mode);
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Returns the number of the newest file of a name, or -1 if none has been created.
+ */
+int File_Index::GetLatest(const char *name) {
+    return ReadCounter(name) - 1;
+}
@@ -0,0 +1,228 @@
+#include "Flight_Recorder.h"
+#include "Loop_Profiler.h"
+#include "File_Index.h"
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+// Recorder Constants
+const uint32_t ringCapacity = 500;
+const uint32_t errorCapacity = 8;
+const int maxWatched = 8;
+const uint32_t watchdogPeriod = 100;
+
+pros::Task *Flight_Recorder::watchdogTask = nullptr;
+pros::Task *Flight_Recorder::writerTask = nullptr;
+std::atomic<const char *> Flight_Recorder::pendingReason(nullptr);
+pros::Mutex Flight_Recorder::ringMutex;
+TelemetryRecord Flight_Recorder::ring[ringCapacity];
+uint32_t Flight_Recorder::ringHead = 0;
+Flight_Recorder::ErrnoEntry Flight_Recorder::errors[errorCapacity];
+uint32_t Flight_Recorder::errorHead = 0;
+
+// Copies of the rings taken under ringMutex, so the SD write can run unlocked
+TelemetryRecord Flight_Recorder::ringSnapshot[ringCapacity];
+Flight_Recorder::ErrnoEntry Flight_Recorder::errorSnapshot[errorCapacity];
+Flight_Recorder::Watched Flight_Recorder::watched[maxWatched];
+int Flight_Recorder::watchedCount = 0;
+
+// Task state names, indexed by task_state_e_t
+static const char *stateNames[] = {"running", "ready", "blocked", "suspended", "deleted", "invalid"};
+
+/**
+ * @brief Starts the watchdog and dump writer tasks if they are not already running.
+ *
+ * The watchdog runs just below the highest priority so that a control loop
+ * spinning without yielding cannot starve it. It only notices faults; the SD
+ * write happens on a low-priority writer task so it never holds up the
+ * control loops.
+ */
+void Flight_Recorder::Start() {
+    if (writerTask == nullptr) {
+        writerTask = new pros::Task(WriterTask, nullptr, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT,
+                                    "Flight Recorder Writer Task");
+    }
+    if (watchdogTask == nullptr) {
+        watchdogTask = new pros::Task(WatchdogTask, nullptr, TASK_PRIORITY_MAX - 1, TASK_STACK_DEPTH_DEFAULT,
+                                      "Flight Recorder Task");
+    }
+}
+
+/**
+ * @brief Watches a task's loop for stalls.
+ */
+void Flight_Recorder::Watch(const char *taskName, const char *profileName, uint32_t timeout) {
+    if (watchedCount >= maxWatched) return;
+    watched[watchedCount++] = Watched{taskName, profileName, timeout, 0, pros::millis(), false};
+}
+
+/**
+ * @brief Adds a telemetry sample to the ring, overwriting the oldest one.
+ */
+void Flight_Recorder::Push(const TelemetryRecord &record) {
+    ringMutex.take();
+    ring[ringHead % ringCapacity] = record;
+    ringHead++;
+    ringMutex.give();
+}
+
+/**
+ * @brief Remembers a non-zero errno value for the next dump.
+ */
+void Flight_Recorder::NoteErrno(int error) {
+    if (error == 0) return;
+    ringMutex.take();
+    errors[errorHead % errorCapacity] = ErrnoEntry{pros::millis(), error};
+    errorHead++;
+    ringMutex.give();
+}
+
+/**
+ * @brief Asks the writer task to dump the ring.
+ *
+ * Returns straight away, so it is safe to call from a control loop. If a dump
+ * is already waiting to be written, the newer reason replaces it.
+ */
+void Flight_Recorder::Dump(const char *reason) {
+    pendingReason = reason;
+    if (writerTask != nullptr) {
+        writerTask->notify();
+    }
+}
+
+/**
+ * @brief Writes a single channel value from a record as text.
+ */
+static void PrintChannel(FILE *file, const TelemetryRecord &record, const Telemetry::Channel &channel) {
+    const uint8_t *field = reinterpret_cast<const uint8_t *>(&record) + channel.offset;
+    uint16_t u16;
+    int16_t i16;
+    uint32_t u32;
+    int32_t i32;
+    float f32;
+
+    switch (channel.type) {
+        case Telemetry::U16: memcpy(&u16, field, sizeof(u16)); fprintf(file, "%u", u16); break;
+        case Telemetry::I16: memcpy(&i16, field, sizeof(i16)); fprintf(file, "%d", i16); break;
+        case Telemetry::U32: memcpy(&u32, field, sizeof(u32)); fprintf(file, "%" PRIu32, u32); break;
+        case Telemetry::I32: memcpy(&i32, field, sizeof(i32)); fprintf(file, "%" PRId32, i32); break;
+        case Telemetry::F32: memcpy(&f32, field, sizeof(f32)); fprintf(file, "%.3f", f32); break;
+    }
+}
+
+/**
+ * @brief Writes the ring and task state to the SD card.
+ *
+ * Dumps are rare, so they are written as plain text: a summary of the watched
+ * tasks and recent errno values, followed by the ring as CSV. The rings are
+ * copied under ringMutex first, so Push never waits on the SD card and no
+ * record is written half updated.
+ *
+ * @param reason A short description of why the dump was taken.
+ */
+void Flight_Recorder::WriteDump(const char *reason) {
+    if (!pros::usd::is_installed()) return;
+
+    ringMutex.take();
+    uint32_t end = ringHead;
+    uint32_t errorEnd = errorHead;
+    memcpy(ringSnapshot, ring, sizeof(ringSnapshot));
+    memcpy(errorSnapshot, errors, sizeof(errorSnapshot));
+    ringMutex.give();
+
+    FILE *file = File_Index::OpenNext("fault", ".txt", "w");
+    if (file == nullptr) return;
+
+    fprintf(file, "reason: %s\ntime: %" PRIu32 "\n\ntasks:\n", reason, pros::millis());
+    for (int i = 0; i < watchedCount; i++) {
+        pros::task_t handle = pros::c::task_get_by_name(watched[i].taskName);
+        if (handle == nullptr) {
+            fprintf(file, "  %-24s not running\n", watched[i].taskName);
+            continue;
+        }
+        fprintf(file, "  %-24s %-9s priority %" PRIu32 "%s\n", watched[i].taskName,
+                stateNames[pros::c::task_get_state(handle)], pros::c::task_get_priority(handle),
+                watched[i].stalled ? "  STALLED" : "");
+    }
+
+    fprintf(file, "\nerrno:\n");
+    uint32_t firstError = errorEnd > errorCapacity ? errorEnd - errorCapacity : 0;
+    for (uint32_t i = firstError; i < errorEnd; i++) {
+        const ErrnoEntry &entry = errorSnapshot[i % errorCapacity];
+        fprintf(file, "  %" PRIu32 " %d %s\n", entry.time, entry.error, strerror(entry.error));
+    }
+
+    uint16_t count;
+    const Telemetry::Channel *channels = Telemetry::GetChannels(count);
+    fprintf(file, "\nsamples:\n");
+    for (uint16_t c = 0; c < count; c++) {
+        fprintf(file, c + 1 < count ? "%s," : "%s\n", channels[c].name);
+    }
+
+    uint32_t start = end > ringCapacity ? end - ringCapacity : 0;
+    for (uint32_t i = start; i < end; i++) {
+        for (uint16_t c = 0; c < count; c++) {
+            PrintChannel(file, ringSnapshot[i % ringCapacity], channels[c]);
+            fputc(c + 1 < count ? ',' : '\n', file);
+        }
+    }
+
+    fclose(file);
+}
+
+/**
+ * @brief Writes each requested dump to the SD card.
+ */
+void Flight_Recorder::WriterTask(void *param) {
+    while (true) {
+        pros::Task::notify_take(true, TIMEOUT_MAX);
+
+        const char *reason = pendingReason.exchange(nullptr);
+        if (reason != nullptr) {
+            WriteDump(reason);
+        }
+    }
+}
+
+/**
+ * @brief Checks watched loops for stalls and dumps when the robot is disabled.
+ *
+ * A loop has stalled when its task still exists but its profile has not
+ * recorded an iteration within the timeout. Each stall is dumped once. Dumps
+ * are only requested here and written by the writer task.
+ */
+void Flight_Recorder::WatchdogTask(void *param) {
+    bool wasDisabled = pros::competition::is_disabled();
+
+    while (true) {
+        uint32_t now = pros::millis();
+
+        for (int i = 0; i < watchedCount; i++) {
+            Watched &task = watched[i];
+            const Loop_Profiler::Profile *profile = Loop_Profiler::Find(task.profileName);
+            pros::task_t handle = pros::c::task_get_by_name(task.taskName);
+
+            bool running = handle != nullptr && pros::c::task_get_state(handle) < pros::E_TASK_STATE_SUSPENDED;
+
+            if (profile == nullptr || !running || profile->count != task.lastCount) {
+                task.lastCount = profile ? profile->count : 0;
+                task.lastProgress = now;
+                task.stalled = false;
+                continue;
+            }
+
+            if (!task.stalled && now - task.lastProgress > task.timeout) {
+                task.stalled = true;
+                Dump(task.taskName);
+            }
+        }
+
+        bool disabled = pros::competition::is_disabled();
+        if (disabled && !wasDisabled) {
+            Dump("competition disabled");
+        }
+        wasDisabled = disabled;
+
+        pros::delay(watchdogPeriod);
+    }
+}
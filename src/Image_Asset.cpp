@@ -0,0 +1,146 @@
+#include "Image_Asset.h"
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <vector>
+
+// Packed Image Constants
+const char imageMagic[8] = {'6', '7', '4', '1', 'I', 'M', 'G', '\0'};
+const uint8_t formatLz4Bgr888 = 1;
+const size_t headerSize = 17;
+const size_t minMatch = 4;
+
+static_assert(sizeof(lv_color_t) >= 3, "Image_Asset expands 24-bit pixels in place");
+
+/**
+ * @brief Reads a little-endian integer from an unaligned position.
+ */
+template <typename T> static T ReadLittle(const uint8_t *data) {
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        value |= static_cast<T>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Decodes a packed image into a new LVGL true-colour image.
+ *
+ * The 24-bit pixels are decompressed into the front of the final buffer and
+ * then widened to lv_color_t from the last pixel backwards, so no second
+ * buffer is needed.
+ */
+bool Image_Asset::Decode(const asset &source, lv_img_dsc_t &image) {
+    if (source.size < headerSize || std::memcmp(source.buf, imageMagic, sizeof(imageMagic)) != 0) return false;
+    if (source.buf[8] != formatLz4Bgr888) return false;
+
+    uint16_t width = ReadLittle<uint16_t>(source.buf + 9);
+    uint16_t height = ReadLittle<uint16_t>(source.buf + 11);
+    uint32_t blockSize = ReadLittle<uint32_t>(source.buf + 13);
+    if (headerSize + blockSize > source.size) return false;
+
+    size_t pixels = static_cast<size_t>(width) * height;
+    uint8_t *buffer = new (std::nothrow) uint8_t[pixels * sizeof(lv_color_t)];
+    if (buffer == nullptr) return false;
+
+    if (!Decompress(source.buf + headerSize, blockSize, buffer, pixels * 3)) {
+        delete[] buffer;
+        return false;
+    }
+
+    lv_color_t *colors = reinterpret_cast<lv_color_t *>(buffer);
+    for (size_t i = pixels; i-- > 0;) {
+        const uint8_t *bgr = buffer + i * 3;
+        colors[i] = LV_COLOR_MAKE(bgr[2], bgr[1], bgr[0]);
+    }
+
+    image.header.cf = LV_IMG_CF_TRUE_COLOR;
+    image.header.always_zero = 0;
+    image.header.w = width;
+    image.header.h = height;
+    image.data_size = pixels * sizeof(lv_color_t);
+    image.data = buffer;
+    return true;
+}
+
+/**
+ * @brief Reads a packed image file and decodes it into a new LVGL true-colour image.
+ *
+ * The packed file is only held in memory while it is decoded.
+ */
+bool Image_Asset::Load(const char *path, lv_img_dsc_t &image) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) return false;
+
+    std::vector<uint8_t> data;
+    uint8_t chunk[512];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + read);
+    }
+    fclose(file);
+
+    asset source = {data.data(), data.size()};
+    return Decode(source, image);
+}
+
+/**
+ * @brief Decompresses an LZ4 block, checking every length against both buffers.
+ *
+ * @return True if the block decoded to exactly outputSize bytes.
+ */
+bool Image_Asset::Decompress(const uint8_t *block, size_t blockSize, uint8_t *output, size_t outputSize) {
+    const uint8_t *in = block;
+    const uint8_t *inEnd = block + blockSize;
+    uint8_t *out = output;
+    uint8_t *outEnd = output + outputSize;
+
+    while (in < inEnd) {
+        uint8_t token = *in++;
+
+        size_t literals = token >> 4;
+        if (literals == 15) {
+            uint8_t extra;
+            do {
+                if (in >= inEnd) return false;
+                extra = *in++;
+                literals += extra;
+            } while (extra == 255);
+        }
+        if (literals > static_cast<size_t>(inEnd - in) || literals > static_cast<size_t>(outEnd - out)) return false;
+        std::memcpy(out, in, literals);
+        in += literals;
+        out += literals;
+
+        // The last sequence has literals only
+        if (in == inEnd) break;
+
+        if (inEnd - in < 2) return false;
+        size_t offset = in[0] | in[1] << 8;
+        in += 2;
+
+        size_t match = token & 15;
+        if (match == 15) {
+            uint8_t extra;
+            do {
+                if (in >= inEnd) return false;
+                extra = *in++;
+                match += extra;
+            } while (extra == 255);
+        }
+        match += minMatch;
+
+        if (offset == 0 || offset > static_cast<size_t>(out - output) || match > static_cast<size_t>(outEnd - out)) {
+            return false;
+        }
+
+        // Matches may overlap their own output, so copy byte by byte
+        const uint8_t *from = out - offset;
+        for (size_t i = 0; i < match; i++) {
+            out[i] = from[i];
+        }
+        out += match;
+    }
+
+    return out == outEnd;
+}
@@ -1,11 +1,33 @@
 #include "Robot_Config.h"
 #include "Intake_Control.h"
+#include "Config_Store.h"
+#include "Command_Scheduler.h"
+#include <cmath>
 
 using namespace pros;
 
 // References the global robot configuration object for managing devices.
 extern Robot_Config robotDevices;
 
+// Sorter Constants
+const int ringProximity = 100;              // Optical proximity (0-255) at which a ring is in front of the sensor
+const double sensorToEjectDegrees = 450.0;  // Intake motor travel from a ring at the sensor to it topping the hooks
+const double ejectLatency = 15.0;           // Milliseconds from commanding a pulse to the hooks reversing, plus half a cycle
+const uint32_t ejectPulseTime = 60;         // Length of the reverse pulse, in milliseconds
+const int ejectPower = -127;
+const double opticalIntegrationTime = 10.0; // Fresh hue every scheduler cycle; the default 100 ms misses rings at speed
+
+Intake_Control::SortCommand Intake_Control::sortCommand;
+Intake_Control::Ring Intake_Control::rejectColor = NO_RING;
+int Intake_Control::commandedPower = 0;
+bool Intake_Control::ejecting = false;
+uint32_t Intake_Control::ejectStart = 0;
+bool Intake_Control::ringAtSensor = false;
+bool Intake_Control::ringClassified = false;
+double Intake_Control::ringEntryPosition = 0.0;
+double Intake_Control::ejectPositions[maxTrackedRings];
+int Intake_Control::ejectCount = 0;
+
 /**
  * @brief Activates the intake system at a specified velocity.
  * 
@@ -17,7 +39,8 @@ extern Robot_Config robotDevices;
  */
 void Intake_Control::Intake(int velocityPercent) {
     // Rotates the intake motor forward at the desired speed.
-    robotDevices.intakeMotor.move(127);
+    commandedPower = 127;
+    ApplyPower();
 }
 
 /**
@@ -31,7 +54,8 @@ void Intake_Control::Intake(int velocityPercent) {
  */
 void Intake_Control::Outtake(int velocityPercent) {
     // Rotates the intake motor in reverse at the desired speed.
-    robotDevices.intakeMotor.move(-127);
+    commandedPower = -127;
+    ApplyPower();
 }
 
 /**
@@ -42,5 +66,126 @@ void Intake_Control::Outtake(int velocityPercent) {
  */
 void Intake_Control::StopIntake() {
     robotDevices.intakeMotor.set_brake_mode(E_MOTOR_BRAKE_COAST);
-    robotDevices.intakeMotor.move(0);
+    commandedPower = 0;
+    ApplyPower();
+}
+
+/**
+ * @brief Drives the intake motor with the commanded power, unless an eject pulse is running.
+ */
+void Intake_Control::ApplyPower() {
+    robotDevices.intakeMotor.move(ejecting ? ejectPower : commandedPower);
+}
+
+/**
+ * @brief Starts rejecting rings of one colour.
+ *
+ * @param reject The colour to eject. NO_RING tracks rings without ejecting any.
+ */
+void Intake_Control::StartSorting(Ring reject) {
+    rejectColor = reject;
+    Command_Scheduler::Schedule(&sortCommand);
+}
+
+/**
+ * @brief Stops sorting and forgets the rings being tracked.
+ */
+void Intake_Control::StopSorting() {
+    Command_Scheduler::Cancel(&sortCommand);
+}
+
+/**
+ * @brief Returns the colour of a ring from its hue, using the stored hue calibration.
+ *
+ * Hue is an angle, so red rings read both just above 0 and just below 360;
+ * differences are taken the short way round the circle.
+ *
+ * @param hue Optical sensor hue, in degrees.
+ */
+Intake_Control::Ring Intake_Control::ClassifyHue(double hue) {
+    const StoredConfig &config = Config_Store::Get();
+
+    double redError = std::fabs(std::remainder(hue - config.redRingHue, 360.0));
+    double blueError = std::fabs(std::remainder(hue - config.blueRingHue, 360.0));
+
+    if (redError <= config.ringHueTolerance && redError <= blueError) return RED_RING;
+    if (blueError <= config.ringHueTolerance) return BLUE_RING;
+    return NO_RING;
+}
+
+/**
+ * @brief Turns on the sensor's light and fast sampling, and forgets any old rings.
+ */
+void Intake_Control::SortCommand::Initialize() {
+    robotDevices.optical.set_led_pwm(100);
+    robotDevices.optical.set_integration_time(opticalIntegrationTime);
+
+    ejecting = false;
+    ringAtSensor = false;
+    ejectCount = 0;
+}
+
+/**
+ * @brief Tracks rings past the optical sensor and fires the eject pulses.
+ *
+ * A ring is timed from the motor position at which it first reached the
+ * sensor, and classified on the first cycle its hue matches a colour. A
+ * rejected ring is ejected at that position plus the hook travel to the top.
+ * The pulse is fired early by the distance the hooks cover in the pulse's
+ * latency, so the reversal lands on the ring rather than a cycle behind it.
+ */
+void Intake_Control::SortCommand::Execute() {
+    double position = robotDevices.intakeMotor.get_position();
+
+    // Rings leave backwards when the intake reverses, so stop tracking them
+    if (commandedPower < 0) ejectCount = 0;
+
+    bool present = robotDevices.optical.get_proximity() >= ringProximity;
+    if (present && !ringAtSensor) {
+        ringEntryPosition = position;
+        ringClassified = false;
+    }
+    ringAtSensor = present;
+
+    if (present && !ringClassified) {
+        Ring color = ClassifyHue(robotDevices.optical.get_hue());
+        if (color != NO_RING) {
+            ringClassified = true;
+            if (color == rejectColor && ejectCount < maxTrackedRings) {
+                ejectPositions[ejectCount++] = ringEntryPosition + sensorToEjectDegrees;
+            }
+        }
+    }
+
+    if (ejecting) {
+        if (pros::millis() - ejectStart >= ejectPulseTime) {
+            ejecting = false;
+            ApplyPower();
+        }
+        return;
+    }
+
+    if (ejectCount == 0 || commandedPower <= 0) return;
+
+    // Motor velocity is in rpm; 6 degrees per millisecond per 1000 rpm
+    double lead = robotDevices.intakeMotor.get_actual_velocity() * 0.006 * ejectLatency;
+    if (position + lead >= ejectPositions[0]) {
+        for (int i = 1; i < ejectCount; i++) {
+            ejectPositions[i - 1] = ejectPositions[i];
+        }
+        ejectCount--;
+
+        ejecting = true;
+        ejectStart = pros::millis();
+        ApplyPower();
+    }
+}
+
+/**
+ * @brief Ends any eject pulse and hands the motor back to the commanded power.
+ */
+void Intake_Control::SortCommand::End(bool interrupted) {
+    ejecting = false;
+    ejectCount = 0;
+    ApplyPower();
 }
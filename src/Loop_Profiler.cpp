@@ -0,0 +1,200 @@
+#include "Loop_Profiler.h"
+#include "Brain_UI.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+// Profiler Constants
+const int maxProfiles = 16;
+const uint32_t reportPeriod = 500;
+
+constexpr uint32_t Loop_Profiler::bucketEdges[];
+Loop_Profiler::Profile Loop_Profiler::profiles[maxProfiles];
+int Loop_Profiler::profileCount = 0;
+pros::Mutex Loop_Profiler::profileMutex;
+lv_obj_t *Loop_Profiler::reportScreen = nullptr;
+lv_obj_t *Loop_Profiler::reportLabel = nullptr;
+
+/**
+ * @brief Registers a loop to be profiled.
+ *
+ * Registering the same name twice returns the existing profile, so a loop can
+ * register itself every time its task starts. Tasks register as they start,
+ * often at the same time, so the table is guarded while it grows.
+ *
+ * @param name A string literal naming the loop.
+ * @param deadline The longest an iteration may take, in microseconds.
+ * @return The loop's profile, or nullptr if the profile table is full.
+ */
+Loop_Profiler::Profile *Loop_Profiler::Register(const char *name, uint32_t deadline) {
+    profileMutex.take();
+
+    Profile *profile = nullptr;
+    for (int i = 0; i < profileCount; i++) {
+        if (strcmp(profiles[i].name, name) == 0) profile = &profiles[i];
+    }
+
+    if (profile == nullptr && profileCount < maxProfiles) {
+        profile = &profiles[profileCount];
+        *profile = Profile{};
+        profile->name = name;
+        profile->deadline = deadline;
+        profileCount++;
+    }
+
+    profileMutex.give();
+    return profile;
+}
+
+/**
+ * @brief Looks up a registered profile by name.
+ */
+const Loop_Profiler::Profile *Loop_Profiler::Find(const char *name) {
+    for (int i = 0; i < profileCount; i++) {
+        if (strcmp(profiles[i].name, name) == 0) return &profiles[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Adds one iteration time to a profile.
+ */
+void Loop_Profiler::Record(Profile *profile, uint32_t elapsed) {
+    if (profile == nullptr) return;
+
+    int bucket = 0;
+    while (elapsed > bucketEdges[bucket]) bucket++;
+
+    profileMutex.take();
+    profile->buckets[bucket]++;
+    profile->count++;
+    profile->total += elapsed;
+    if (elapsed > profile->worst) profile->worst = elapsed;
+    if (elapsed > profile->deadline) profile->misses++;
+    profileMutex.give();
+}
+
+/**
+ * @brief Returns a consistent copy of a profile's statistics.
+ *
+ * The total is 64 bits, which the Cortex-A9 cannot read in one access, so
+ * readers on other tasks copy the profile under the same mutex Record holds.
+ */
+Loop_Profiler::Profile Loop_Profiler::Snapshot(const Profile &profile) {
+    profileMutex.take();
+    Profile copy = profile;
+    profileMutex.give();
+    return copy;
+}
+
+/**
+ * @brief Returns the bucket edge below which a fraction of iterations finished.
+ */
+uint32_t Loop_Profiler::Percentile(const Profile &profile, double fraction) {
+    uint32_t target = profile.count * fraction;
+    uint32_t seen = 0;
+
+    for (int bucket = 0; bucket < bucketCount; bucket++) {
+        seen += profile.buckets[bucket];
+        if (seen > target) return std::min(bucketEdges[bucket], profile.worst);
+    }
+    return profile.worst;
+}
+
+/**
+ * @brief Clears the statistics of every profile.
+ */
+void Loop_Profiler::Reset() {
+    profileMutex.take();
+    for (int i = 0; i < profileCount; i++) {
+        Profile &profile = profiles[i];
+        profile = Profile{profile.name, profile.deadline};
+    }
+    profileMutex.give();
+}
+
+/**
+ * @brief Prints every profile and its histogram to the terminal.
+ */
+void Loop_Profiler::PrintReport() {
+    printf("%-20s %8s %8s %8s %8s %8s %8s\n", "loop", "count", "avg us", "p99 us", "max us", "dl us", "misses");
+
+    for (int i = 0; i < profileCount; i++) {
+        const Profile profile = Snapshot(profiles[i]);
+        uint32_t average = profile.count ? profile.total / profile.count : 0;
+        printf("%-20s %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 "\n",
+               profile.name, profile.count, average,
+               Percentile(profile, 0.99), profile.worst, profile.deadline, profile.misses);
+
+        printf("    ");
+        for (int bucket = 0; bucket < bucketCount; bucket++) {
+            if (bucket < bucketCount - 1) {
+                printf("<=%" PRIu32 ":%" PRIu32 " ", bucketEdges[bucket], profile.buckets[bucket]);
+            } else {
+                printf(">%" PRIu32 ":%" PRIu32 "\n", bucketEdges[bucket - 1], profile.buckets[bucket]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Switches the Brain screen to the profiler report, building it on first use.
+ */
+void Loop_Profiler::ShowReport() {
+    if (reportScreen == nullptr) {
+        BuildReport();
+    }
+    lv_scr_load(reportScreen);
+    RefreshReport(nullptr);
+}
+
+/**
+ * @brief Creates the report page and the LVGL task that keeps it up to date.
+ *
+ * The page is built once and only its label text changes afterwards, so it
+ * can stay open without growing LVGL memory.
+ */
+void Loop_Profiler::BuildReport() {
+    reportScreen = lv_obj_create(NULL, NULL);
+
+    lv_obj_t *backButton = lv_btn_create(reportScreen, NULL);
+    lv_btn_set_action(backButton, LV_BTN_ACTION_CLICK, BackAction);
+    lv_obj_set_size(backButton, 80, 36);
+    lv_obj_align(backButton, NULL, LV_ALIGN_IN_TOP_RIGHT, -10, 7);
+    lv_obj_t *backLabel = lv_label_create(backButton, NULL);
+    lv_label_set_text(backLabel, "Back");
+
+    reportLabel = lv_label_create(reportScreen, NULL);
+    lv_label_set_text(reportLabel, "");
+    lv_obj_set_pos(reportLabel, 10, 10);
+
+    lv_task_create(RefreshReport, reportPeriod, LV_TASK_PRIO_LOW, nullptr);
+}
+
+/**
+ * @brief Rewrites the report label from the current profiles. Runs as an LVGL task.
+ *
+ * Does nothing while another screen is shown.
+ */
+void Loop_Profiler::RefreshReport(void *param) {
+    if (lv_scr_act() != reportScreen) return;
+
+    static char text[maxProfiles * 64];
+    int length = snprintf(text, sizeof(text), "loop  avg / p99 / max us  misses\n");
+
+    for (int i = 0; i < profileCount && length < (int)sizeof(text); i++) {
+        const Profile profile = Snapshot(profiles[i]);
+        uint32_t average = profile.count ? profile.total / profile.count : 0;
+        length += snprintf(text + length, sizeof(text) - length,
+                           "%s  %" PRIu32 " / %" PRIu32 " / %" PRIu32 "  %" PRIu32 "\n", profile.name, average,
+                           Percentile(profile, 0.99), profile.worst, profile.misses);
+    }
+
+    lv_label_set_text(reportLabel, text);
+}
+
+lv_res_t Loop_Profiler::BackAction(lv_obj_t *btn) {
+    Brain_UI::DisplayAutonSelectorUI();
+    return LV_RES_OK;
+}
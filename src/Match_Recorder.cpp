@@ -0,0 +1,272 @@
+#include "Robot_Config.h"
+#include "Match_Recorder.h"
+#include "Deferred_Log.h"
+#include "File_Index.h"
+#include <cstring>
+
+extern Robot_Config robotDevices;
+
+// Recorder Constants
+const char *replayPath = "/usd/replay.bin";
+const char logMagic[8] = {'6', '7', '4', '1', 'M', 'R', 'C', '\0'};
+const uint16_t logVersion = 1;
+const uint32_t recorderPeriod = 50;
+const int flushEvery = 5;
+const int noAutonomous = -1;
+
+pros::Controller *Match_Recorder::controller = nullptr;
+pros::Task *Match_Recorder::recorderTask = nullptr;
+FILE *Match_Recorder::logFile = nullptr;
+Byte_Ring<4096> Match_Recorder::inputRing;
+ControllerSnapshot Match_Recorder::lastInput{};
+bool Match_Recorder::hasInput = false;
+int Match_Recorder::autonomous = noAutonomous;
+
+std::atomic<bool> Match_Recorder::replaying{false};
+bool Match_Recorder::replayStarted = false;
+std::vector<Match_Recorder::ReplayEvent> Match_Recorder::replayEvents;
+size_t Match_Recorder::replayIndex = 0;
+uint32_t Match_Recorder::replayOffset = 0;
+int Match_Recorder::replayAutonomous = noAutonomous;
+
+/**
+ * @brief Returns the payload size of a record type.
+ */
+static uint32_t RecordSize(uint8_t type) {
+    switch (type) {
+        case Match_Recorder::CONTROLLER: return sizeof(ControllerSnapshot);
+        case Match_Recorder::COMPETITION: return sizeof(uint8_t);
+        case Match_Recorder::AUTONOMOUS: return sizeof(int32_t);
+        case Match_Recorder::SENSORS: return sizeof(Match_Recorder::SensorSnapshot);
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Starts recording a new match log.
+ */
+void Match_Recorder::Start(pros::Controller &controller) {
+    Match_Recorder::controller = &controller;
+    if (recorderTask != nullptr || !pros::usd::is_installed()) return;
+
+    logFile = File_Index::OpenNext("match", ".bin", "wb");
+    if (logFile == nullptr) return;
+
+    fwrite(logMagic, sizeof(logMagic), 1, logFile);
+    fwrite(&logVersion, sizeof(logVersion), 1, logFile);
+
+    recorderTask = new pros::Task(RecorderTask, nullptr, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT,
+                                  "Match Recorder Task");
+}
+
+/**
+ * @brief Plays /usd/replay.bin back in place of the controller.
+ *
+ * A replay drives the robot without the driver, so it is never allowed on a
+ * field or competition switch. The log is only read once; later replays
+ * start it again from the beginning.
+ *
+ * @return False if replay was refused or the log could not be read.
+ */
+bool Match_Recorder::StartReplay() {
+    if (pros::competition::is_connected() || !pros::usd::is_installed()) return false;
+
+    if (replayEvents.empty() && !LoadReplay(replayPath)) {
+        Deferred_Log::Warn("No match log to replay at {}", replayPath);
+        return false;
+    }
+
+    Deferred_Log::Info("Replaying {} controller events", static_cast<uint32_t>(replayEvents.size()));
+    replaying = true;
+    return true;
+}
+
+/**
+ * @brief Hands control back to the controller.
+ */
+void Match_Recorder::StopReplay() {
+    replaying = false;
+}
+
+/**
+ * @brief Returns true while a recorded log is being played back.
+ */
+bool Match_Recorder::IsReplaying() {
+    return replaying;
+}
+
+/**
+ * @brief Loads the controller events and autonomous selection from a log.
+ *
+ * @return True if the file existed and was a match log.
+ */
+bool Match_Recorder::LoadReplay(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) return false;
+
+    replayEvents.clear();
+    replayAutonomous = noAutonomous;
+
+    char magic[sizeof(logMagic)];
+    uint16_t version;
+    if (fread(magic, sizeof(magic), 1, file) != 1 || memcmp(magic, logMagic, sizeof(magic)) != 0 ||
+        fread(&version, sizeof(version), 1, file) != 1 || version != logVersion) {
+        fclose(file);
+        return false;
+    }
+
+    uint8_t type;
+    uint32_t time;
+    uint8_t payload[sizeof(SensorSnapshot)];
+    while (fread(&type, 1, 1, file) == 1 && fread(&time, sizeof(time), 1, file) == 1) {
+        uint32_t size = RecordSize(type);
+        if (size == 0 || fread(payload, size, 1, file) != 1) break;
+
+        if (type == CONTROLLER) {
+            ReplayEvent event;
+            event.time = time;
+            memcpy(&event.input, payload, sizeof(event.input));
+            replayEvents.push_back(event);
+        } else if (type == AUTONOMOUS) {
+            int32_t selected;
+            memcpy(&selected, payload, sizeof(selected));
+            replayAutonomous = selected;
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Returns the controller input for this driver control iteration.
+ *
+ * Replay time starts at the first poll after the replay is turned on, which
+ * lines up with the first recorded controller event because recording also
+ * starts at the first poll. Connecting to a field ends a replay at once.
+ */
+ControllerSnapshot Match_Recorder::Poll() {
+    uint32_t now = pros::millis();
+
+    if (replaying && pros::competition::is_connected()) {
+        replaying = false;
+    }
+
+    if (!replaying) {
+        replayStarted = false;
+    } else {
+        if (replayEvents.empty()) return ControllerSnapshot{};
+        if (!replayStarted) {
+            replayIndex = 0;
+            replayOffset = now - replayEvents[0].time;
+            replayStarted = true;
+        }
+
+        while (replayIndex + 1 < replayEvents.size() && replayEvents[replayIndex + 1].time + replayOffset <= now) {
+            replayIndex++;
+        }
+        return replayEvents[replayIndex].input;
+    }
+
+    ControllerSnapshot input = ControllerSnapshot::Read(*controller);
+    if (logFile != nullptr && (!hasInput || input != lastInput)) {
+        uint8_t record[1 + sizeof(now) + sizeof(input)];
+        record[0] = CONTROLLER;
+        memcpy(record + 1, &now, sizeof(now));
+        memcpy(record + 1 + sizeof(now), &input, sizeof(input));
+        inputRing.Write(record, sizeof(record));
+    }
+
+    lastInput = input;
+    hasInput = true;
+    return input;
+}
+
+/**
+ * @brief Records the selected autonomous, or returns the recorded one during replay.
+ */
+int Match_Recorder::SelectAutonomous(int selected) {
+    if (replaying && replayAutonomous != noAutonomous) {
+        return replayAutonomous;
+    }
+
+    autonomous = selected;
+    return selected;
+}
+
+/**
+ * @brief Writes one record straight to the log file.
+ */
+void Match_Recorder::WriteRecord(RecordType type, uint32_t time, const void *data, uint32_t size) {
+    fwrite(&type, sizeof(type), 1, logFile);
+    fwrite(&time, sizeof(time), 1, logFile);
+    fwrite(data, size, 1, logFile);
+}
+
+/**
+ * @brief Records state changes and sensor snapshots, and flushes the log.
+ *
+ * Controller events arrive through the input ring from the driver control
+ * task; everything else is sampled and written here, so each buffer keeps a
+ * single producer. Records are written in time order: the drained controller
+ * events from before this cycle's timestamp go first, then this cycle's
+ * records, then any events stamped after it.
+ */
+void Match_Recorder::RecorderTask(void *param) {
+    static uint8_t events[sizeof(inputRing)];
+    const uint32_t eventSize = 1 + sizeof(uint32_t) + sizeof(ControllerSnapshot);
+    uint8_t lastStatus = 0xFF;
+    int lastAutonomous = noAutonomous;
+    int iteration = 0;
+    uint32_t now = pros::millis();
+
+    while (true) {
+        uint32_t time = pros::millis();
+
+        // The ring only ever holds whole controller records
+        uint32_t length = 0;
+        inputRing.Drain([&length](const uint8_t *data, uint32_t size) {
+            memcpy(events + length, data, size);
+            length += size;
+        });
+
+        uint32_t earlier = 0;
+        while (earlier + eventSize <= length) {
+            uint32_t eventTime;
+            memcpy(&eventTime, events + earlier + 1, sizeof(eventTime));
+            if (eventTime > time) break;
+            earlier += eventSize;
+        }
+        fwrite(events, 1, earlier, logFile);
+
+        uint8_t status = pros::competition::get_status();
+        if (status != lastStatus) {
+            WriteRecord(COMPETITION, time, &status, sizeof(status));
+            lastStatus = status;
+        }
+
+        int32_t selected = autonomous;
+        if (selected != lastAutonomous) {
+            WriteRecord(AUTONOMOUS, time, &selected, sizeof(selected));
+            lastAutonomous = selected;
+        }
+
+        lemlib::Pose pose = robotDevices.chassis.getPose();
+        SensorSnapshot sensors;
+        sensors.poseX = pose.x;
+        sensors.poseY = pose.y;
+        sensors.poseTheta = pose.theta;
+        sensors.imuHeading = robotDevices.imu.get_heading();
+        sensors.armAngle = robotDevices.armRotation.get_position();
+        sensors.verticalTicks = robotDevices.vertical_encoder.get_position();
+        sensors.horizontalTicks = robotDevices.horizontal_encoder.get_position();
+        WriteRecord(SENSORS, time, &sensors, sizeof(sensors));
+
+        fwrite(events + earlier, 1, length - earlier, logFile);
+        if (++iteration % flushEvery == 0) {
+            fflush(logFile);
+        }
+
+        pros::Task::delay_until(&now, recorderPeriod);
+    }
+}
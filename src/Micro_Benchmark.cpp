@@ -0,0 +1,182 @@
+#include "Micro_Benchmark.h"
+#include "Drive_Curve_Table.h"
+#include "File_Index.h"
+#include "lemlib/api.hpp"
+#include "okapi/api/filter/emaFilter.hpp"
+#include "okapi/api/filter/medianFilter.hpp"
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+// Benchmark Constants
+const int batchIterations = 1000;
+const int batchCount = 9;
+const int resultsVersion = 2;
+
+// Inputs are read and outputs written through volatiles so the compiler
+// cannot fold a benchmark away or hoist it out of its batch
+static volatile float input = 12.5f;
+static volatile float sink = 0.0f;
+
+static void PoseArithmetic(int iterations) {
+    lemlib::Pose a(input, 4.0f, 1.0f);
+    lemlib::Pose b(2.0f, input, 0.5f);
+    for (int i = 0; i < iterations; i++) {
+        lemlib::Pose c = (a + b) * 0.5f - a;
+        sink = c.x + c.distance(b);
+    }
+}
+
+static void PidUpdate(int iterations) {
+    lemlib::PID pid(10, 0.1, 3, 3);
+    for (int i = 0; i < iterations; i++) {
+        sink = pid.update(input);
+    }
+}
+
+static void AngleError(int iterations) {
+    for (int i = 0; i < iterations; i++) {
+        sink = lemlib::angleError(input, 350.0f, false);
+    }
+}
+
+static void Curvature(int iterations) {
+    lemlib::Pose pose(0.0f, 0.0f, 0.3f);
+    lemlib::Pose other(input, 24.0f, 1.1f);
+    for (int i = 0; i < iterations; i++) {
+        sink = lemlib::getCurvature(pose, other);
+    }
+}
+
+static void ExpoCurve(int iterations) {
+    lemlib::ExpoDriveCurve curve(3, 10, 1.019);
+    for (int i = 0; i < iterations; i++) {
+        sink = curve.curve(input * 8);
+    }
+}
+
+static void TableCurve(int iterations) {
+    static Drive_Curve_Table curve(Expo_Shape{3, 10, 1.019f});
+    for (int i = 0; i < iterations; i++) {
+        sink = curve.curve(input * 8);
+    }
+}
+
+static void EmaFilter(int iterations) {
+    okapi::EmaFilter filter(0.2);
+    for (int i = 0; i < iterations; i++) {
+        sink = filter.filter(input);
+    }
+}
+
+static void MedianFilter(int iterations) {
+    okapi::MedianFilter<5> filter;
+    for (int i = 0; i < iterations; i++) {
+        sink = filter.filter(input + i % 7);
+    }
+}
+
+static void FmtFormat(int iterations) {
+    fmt::memory_buffer buffer;
+    for (int i = 0; i < iterations; i++) {
+        buffer.clear();
+        fmt::format_to(std::back_inserter(buffer), "x={:.2f} y={:.2f} arm={}", input, input * 2, i);
+        sink = buffer.size();
+    }
+}
+
+/**
+ * @brief A benchmark and the batch function that exercises it.
+ */
+struct Benchmark {
+    const char *name;
+    void (*batch)(int iterations);
+};
+
+// No thresholds are kept here: a pass or fail is only meaningful against a
+// measured baseline, which tools/benchmark_compare.py compares runs with
+static const Benchmark benchmarks[] = {
+    {"pose_arithmetic", PoseArithmetic},
+    {"pid_update", PidUpdate},
+    {"angle_error", AngleError},
+    {"get_curvature", Curvature},
+    {"expo_curve", ExpoCurve},
+    {"table_curve", TableCurve},
+    {"ema_filter", EmaFilter},
+    {"median_filter", MedianFilter},
+    {"fmt_format", FmtFormat},
+};
+static const int benchmarkCount = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+Micro_Benchmark::Result Micro_Benchmark::results[benchmarkCount];
+int Micro_Benchmark::resultCount = 0;
+
+/**
+ * @brief Times a batch function and returns the median nanoseconds per call.
+ *
+ * One untimed batch warms the caches first. Taking the median of several
+ * batches keeps a task switch or interrupt in one batch from skewing the result.
+ */
+uint32_t Micro_Benchmark::Measure(void (*batch)(int iterations)) {
+    uint32_t samples[batchCount];
+
+    batch(batchIterations);
+    for (int i = 0; i < batchCount; i++) {
+        uint64_t start = pros::micros();
+        batch(batchIterations);
+        samples[i] = (pros::micros() - start) * 1000 / batchIterations;
+    }
+
+    std::nth_element(samples, samples + batchCount / 2, samples + batchCount);
+    return samples[batchCount / 2];
+}
+
+/**
+ * @brief Runs every benchmark and reports the results.
+ */
+void Micro_Benchmark::Run() {
+    resultCount = 0;
+    for (const Benchmark &benchmark : benchmarks) {
+        Result &result = results[resultCount++];
+        result.name = benchmark.name;
+        result.nanoseconds = Measure(benchmark.batch);
+    }
+
+    Report();
+}
+
+/**
+ * @brief Returns the results of the last run.
+ */
+const Micro_Benchmark::Result *Micro_Benchmark::GetResults(int &count) {
+    count = resultCount;
+    return results;
+}
+
+/**
+ * @brief Prints the results to the terminal and saves them to /usd/bench_NNN.csv.
+ *
+ * Both use the same line format, "BENCH,version,name,ns", so a log captured
+ * from the terminal can be compared just like a file. No pass or fail is
+ * printed; that is decided on the host against a saved baseline.
+ */
+void Micro_Benchmark::Report() {
+    FILE *file = nullptr;
+
+    if (pros::usd::is_installed()) {
+        file = File_Index::OpenNext("bench", ".csv", "w");
+    }
+
+    for (int i = 0; i < resultCount; i++) {
+        const Result &result = results[i];
+
+        printf("BENCH,%d,%s,%" PRIu32 "\n", resultsVersion, result.name, result.nanoseconds);
+        if (file != nullptr) {
+            fprintf(file, "BENCH,%d,%s,%" PRIu32 "\n", resultsVersion, result.name, result.nanoseconds);
+        }
+    }
+
+    if (file != nullptr) fclose(file);
+}
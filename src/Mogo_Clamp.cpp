@@ -37,3 +37,10 @@ void Mogo_Clamp::Unclamp() {
     robotDevices.mogoClampPiston2.set_value(true);
     isClamped = false;
 }
+
+/**
+ * @brief Returns whether the clamp is currently engaged.
+ */
+bool Mogo_Clamp::IsClamped() const {
+    return isClamped;
+}
@@ -0,0 +1,259 @@
+#include "Robot_Config.h"
+#include "Power_Governor.h"
+#include "Loop_Profiler.h"
+#include "Thermal_Model.h"
+#include "pros/misc.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+extern Robot_Config robotDevices;
+
+pros::Task *Power_Governor::governorTask = nullptr;
+int Power_Governor::priorities[GROUP_COUNT] = {3, 2, 1};
+int Power_Governor::motorLimits[GROUP_COUNT] = {2500, 2500, 2500};
+std::atomic<double> Power_Governor::driveScale{1.0};
+std::atomic<double> Power_Governor::tractionScale{1.0};
+pros::Mutex Power_Governor::driveLimitMutex;
+int Power_Governor::driveVoltageLimit = 12000;
+
+// Budget Constants (mA / mV)
+const double totalBudget = 20000.0;
+const double motorMaxCurrent = 2500.0;
+const double motorMinCurrent = 600.0;
+const double saturatedRatio = 0.9;
+const double batteryNominal = 12800.0;
+const double batteryBrownout = 10500.0;
+const double minBudgetRatio = 0.6;
+const double minDriveScale = 0.5;
+const double scaleSmoothing = 0.2;
+const int limitHysteresis = 50;
+const int maxDriveVoltage = 12000;
+const int voltageHysteresis = 100;
+const int governorPeriod = 20;
+
+// Motors belonging to each group, in the same order as the Group enum
+static pros::Motor *driveMotors[] = {
+    &robotDevices.frontLeftMotor, &robotDevices.lowerLeftMotor, &robotDevices.upperLeftMotor,
+    &robotDevices.frontRightMotor, &robotDevices.lowerRightMotor, &robotDevices.upperRightMotor
+};
+static pros::Motor *armMotors[] = {&robotDevices.armMotor1, &robotDevices.armMotor2};
+static pros::Motor *intakeMotors[] = {&robotDevices.intakeMotor};
+
+static pros::Motor **groupMotors[Power_Governor::GROUP_COUNT] = {driveMotors, armMotors, intakeMotors};
+static const int groupSizes[Power_Governor::GROUP_COUNT] = {6, 2, 1};
+
+/**
+ * @brief Starts the governor task if it is not already running.
+ */
+void Power_Governor::Start() {
+    if (governorTask == nullptr) {
+        governorTask = new pros::Task(GovernorTask, nullptr, "Power Governor Task");
+    }
+}
+
+/**
+ * @brief Stops the governor task and restores the default motor limits.
+ */
+void Power_Governor::Stop() {
+    if (governorTask != nullptr) {
+        governorTask->remove();
+        delete governorTask;
+        governorTask = nullptr;
+    }
+
+    for (int group = 0; group < GROUP_COUNT; group++) {
+        motorLimits[group] = 0;
+        ApplyLimits(static_cast<Group>(group), motorMaxCurrent);
+    }
+    driveScale = 1.0;
+    WriteDriveLimit();
+}
+
+/**
+ * @brief Returns the motors that belong to a group.
+ *
+ * @param group The motor group to query.
+ * @param count Set to the number of motors in the group.
+ */
+pros::Motor *const *Power_Governor::GetMotors(Group group, int &count) {
+    count = groupSizes[group];
+    return groupMotors[group];
+}
+
+/**
+ * @brief Sets the priority of a motor group.
+ *
+ * @param group The motor group to configure.
+ * @param priority Higher values are served first when the budget is short.
+ */
+void Power_Governor::SetPriority(Group group, int priority) {
+    priorities[group] = priority;
+}
+
+/**
+ * @brief Sets the extra drive scale requested by traction control.
+ *
+ * The new scale is written to the drive motors straight away so that lemlib
+ * motions react to wheel slip without waiting for the next allocation.
+ *
+ * @param scale Fraction of drive output to allow, between 0 and 1.
+ */
+void Power_Governor::SetTractionScale(double scale) {
+    tractionScale = std::clamp(scale, 0.0, 1.0);
+    WriteDriveLimit();
+}
+
+/**
+ * @brief Scales a driver drive command by the current drive allocation.
+ *
+ * Scaling the command instead of relying on the voltage limit keeps the ratio
+ * between the left and right side, so the robot still turns the way the
+ * driver asked while it is being governed.
+ *
+ * @param power The raw drive command (-127 to 127).
+ * @return The scaled drive command.
+ */
+int Power_Governor::ScaleDrive(int power) {
+    return static_cast<int>(power * driveScale.load() * tractionScale.load());
+}
+
+/**
+ * @brief Returns the fraction of requested drive current that was granted.
+ */
+double Power_Governor::GetDriveScale() {
+    return driveScale;
+}
+
+/**
+ * @brief Returns the current limit, in mA, granted to each motor of a group.
+ */
+int Power_Governor::GetMotorLimit(Group group) {
+    return motorLimits[group];
+}
+
+/**
+ * @brief Writes a current limit to every motor of a group.
+ *
+ * Limits are only sent when they move by more than the hysteresis, which keeps
+ * the governor from flooding the smart port bus with identical writes.
+ *
+ * @param group The motor group to update.
+ * @param limit The per-motor current limit in mA.
+ */
+void Power_Governor::ApplyLimits(Group group, int limit) {
+    if (std::abs(limit - motorLimits[group]) < limitHysteresis) {
+        return;
+    }
+
+    for (int i = 0; i < groupSizes[group]; i++) {
+        groupMotors[group][i]->set_current_limit(limit);
+    }
+    motorLimits[group] = limit;
+}
+
+/**
+ * @brief Carries the combined drive scale into lemlib's motion output.
+ *
+ * lemlib drives the motor groups directly, so the only way to scale its output
+ * is through the drive motors' voltage limit. Like the current limits, it is
+ * only sent when it moves by more than the hysteresis, except that a return
+ * to the full voltage is always sent. Both the governor and traction control
+ * call this, so the last written limit is guarded.
+ */
+void Power_Governor::WriteDriveLimit() {
+    int limit = maxDriveVoltage * driveScale.load() * tractionScale.load();
+
+    driveLimitMutex.take();
+    bool restore = limit == maxDriveVoltage && driveVoltageLimit != maxDriveVoltage;
+    if (restore || std::abs(limit - driveVoltageLimit) >= voltageHysteresis) {
+        robotDevices.leftMotors.set_voltage_limit(limit);
+        robotDevices.rightMotors.set_voltage_limit(limit);
+        driveVoltageLimit = limit;
+    }
+    driveLimitMutex.give();
+}
+
+/**
+ * @brief Splits the current budget between the motor groups.
+ *
+ * Every group is first given enough current to keep its motors responsive.
+ * The rest of the budget is then handed out in priority order up to what each
+ * group is asking for, and anything left over is shared evenly. A group's
+ * demand is its measured draw, except that a motor pinned at its current limit
+ * is counted as wanting the full motor maximum.
+ */
+void Power_Governor::Allocate() {
+    double demand[GROUP_COUNT];
+    double allocation[GROUP_COUNT];
+
+    for (int group = 0; group < GROUP_COUNT; group++) {
+        demand[group] = 0.0;
+
+        for (int i = 0; i < groupSizes[group]; i++) {
+            pros::Motor *motor = groupMotors[group][i];
+            double draw = motor->get_current_draw();
+            if (draw >= motorLimits[group] * saturatedRatio) {
+                draw = motorMaxCurrent;
+            }
+            demand[group] += std::max(draw, motorMinCurrent);
+        }
+    }
+
+    // Shrink the budget as the battery sags towards brownout
+    double battery = pros::battery::get_voltage();
+    double batteryRatio = (battery - batteryBrownout) / (batteryNominal - batteryBrownout);
+    double budget = totalBudget * std::clamp(batteryRatio, minBudgetRatio, 1.0);
+
+    // Guarantee every group its floor
+    for (int group = 0; group < GROUP_COUNT; group++) {
+        allocation[group] = groupSizes[group] * motorMinCurrent;
+        budget -= allocation[group];
+    }
+
+    // Serve the remaining demand in priority order
+    int order[GROUP_COUNT] = {DRIVE, ARM, INTAKE};
+    std::sort(order, order + GROUP_COUNT, [](int a, int b) { return priorities[a] > priorities[b]; });
+
+    for (int group : order) {
+        double grant = std::clamp(demand[group] - allocation[group], 0.0, std::max(budget, 0.0));
+        allocation[group] += grant;
+        budget -= grant;
+    }
+
+    // Share whatever is left evenly, capped at each group's maximum
+    for (int group = 0; group < GROUP_COUNT; group++) {
+        if (budget <= 0.0) break;
+        double room = groupSizes[group] * motorMaxCurrent - allocation[group];
+        double grant = std::clamp(budget / GROUP_COUNT, 0.0, room);
+        allocation[group] += grant;
+        budget -= grant;
+    }
+
+    for (int group = 0; group < GROUP_COUNT; group++) {
+        // Derate groups heading for their thermal limit before the firmware does it for us
+        double derate = Thermal_Model::GetDerate(static_cast<Group>(group));
+
+        double limit = allocation[group] / groupSizes[group] * derate;
+        ApplyLimits(static_cast<Group>(group), std::clamp(limit, motorMinCurrent, motorMaxCurrent));
+    }
+
+    // Scale drive output by how much of its demand was granted
+    double target = std::clamp(allocation[DRIVE] / demand[DRIVE], minDriveScale, 1.0);
+    driveScale = driveScale.load() + (target - driveScale.load()) * scaleSmoothing;
+    WriteDriveLimit();
+}
+
+/**
+ * @brief Background task that re-allocates the budget every governor period.
+ */
+void Power_Governor::GovernorTask(void *param) {
+    Loop_Profiler::Profile *loopProfile = Loop_Profiler::Register("Power Governor", 5000);
+
+    while (true) {
+        {
+            Loop_Profiler::Scope timer(loopProfile);
+            Allocate();
+        }
+        pros::delay(governorPeriod);
+    }
+}
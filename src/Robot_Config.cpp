@@ -80,5 +80,9 @@ Robot_Config::Robot_Config() :
                             0 // maximum acceleration (slew)
         ),
 
-        chassis(drivetrain, lateralController, angularController, sensors) {}
+        // Driver curves start out linear until Config_Store applies the saved ones
+        throttleCurve(),
+        steerCurve(),
+
+        chassis(drivetrain, lateralController, angularController, sensors, &throttleCurve, &steerCurve) {}
  
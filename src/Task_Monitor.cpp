@@ -0,0 +1,124 @@
+#include "Task_Monitor.h"
+#include "Loop_Profiler.h"
+#include "Deferred_Log.h"
+#include "Controller_Display.h"
+#include <cstdio>
+
+// Monitor Constants
+const int maxWatched = 16;
+const uint32_t monitorPeriod = 1000;
+const float cpuShareLimit = 0.5f;
+
+pros::Task *Task_Monitor::monitorTask = nullptr;
+Task_Monitor::Watched Task_Monitor::watched[maxWatched];
+int Task_Monitor::watchedCount = 0;
+
+/**
+ * @brief Adds a task to the watch list.
+ */
+void Task_Monitor::Watch(const char *taskName, const char *profileName, bool mayExit) {
+    if (watchedCount >= maxWatched) return;
+
+    Watched &task = watched[watchedCount++];
+    task = Watched{taskName, profileName, mayExit, 0, 0, 0.0f, false, false};
+}
+
+/**
+ * @brief Starts the monitor task if it is not already running.
+ */
+void Task_Monitor::Start() {
+    if (monitorTask == nullptr) {
+        monitorTask = new pros::Task(MonitorTask, nullptr, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_MIN * 4,
+                                     "Task Monitor Task");
+    }
+}
+
+/**
+ * @brief Stops the monitor task.
+ */
+void Task_Monitor::Stop() {
+    if (monitorTask != nullptr) {
+        monitorTask->remove();
+        delete monitorTask;
+        monitorTask = nullptr;
+    }
+}
+
+/**
+ * @brief Updates the CPU share and state of every watched task and warns about trouble.
+ *
+ * Each problem is logged every sample it lasts; the controller only rumbles
+ * when a task goes from no problems to some, so a lasting fault is not a
+ * lasting rumble.
+ *
+ * @param elapsed Time since the last sample, in microseconds.
+ */
+void Task_Monitor::Sample(uint32_t elapsed) {
+    bool newWarning = false;
+
+    for (int i = 0; i < watchedCount; i++) {
+        Watched &task = watched[i];
+        bool wasRunning = task.running;
+        bool warning = false;
+
+        task.running = pros::c::task_get_by_name(task.taskName) != nullptr;
+        if (wasRunning && !task.running && !task.mayExit) {
+            Deferred_Log::Warn("Task {} is no longer running", task.taskName);
+            warning = true;
+        }
+
+        const Loop_Profiler::Profile *found = task.profileName ? Loop_Profiler::Find(task.profileName) : nullptr;
+        if (found != nullptr) {
+            Loop_Profiler::Profile profile = Loop_Profiler::Snapshot(*found);
+            task.cpuShare = elapsed ? float(profile.total - task.lastBusy) / elapsed : 0.0f;
+            task.lastBusy = profile.total;
+
+            if (task.cpuShare > cpuShareLimit) {
+                Deferred_Log::Warn("Task {} used {}% of the CPU", task.taskName, int(task.cpuShare * 100.0f));
+                warning = true;
+            }
+            if (profile.misses > task.lastMisses) {
+                Deferred_Log::Warn("Task {} missed {} deadlines", task.taskName, profile.misses - task.lastMisses);
+                warning = true;
+            }
+            task.lastMisses = profile.misses;
+        }
+
+        if (warning && !task.warning) newWarning = true;
+        task.warning = warning;
+    }
+
+    if (newWarning) Controller_Display::Rumble("...");
+}
+
+/**
+ * @brief Prints the CPU share and state of every watched task.
+ */
+void Task_Monitor::PrintReport() {
+    printf("%-28s %8s %10s\n", "task", "cpu %", "state");
+
+    for (int i = 0; i < watchedCount; i++) {
+        const Watched &task = watched[i];
+        const char *state = task.running ? "running" : "stopped";
+        if (task.profileName == nullptr) {
+            printf("%-28s %8s %10s\n", task.taskName, "-", state);
+        } else {
+            printf("%-28s %8.1f %10s\n", task.taskName, task.cpuShare * 100.0f, state);
+        }
+    }
+}
+
+/**
+ * @brief Samples the watched tasks every monitor period.
+ */
+void Task_Monitor::MonitorTask(void *param) {
+    uint64_t last = pros::micros();
+    uint32_t now = pros::millis();
+
+    while (true) {
+        pros::Task::delay_until(&now, monitorPeriod);
+        uint64_t time = pros::micros();
+        Sample(time - last);
+        last = time;
+    }
+}
@@ -0,0 +1,296 @@
+#include "Robot_Config.h"
+#include "Telemetry.h"
+#include "Loop_Profiler.h"
+#include "Flight_Recorder.h"
+#include "File_Index.h"
+#include "pros/misc.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+extern Robot_Config robotDevices;
+
+// Ring Buffer Constants
+const uint32_t flushBlock = 128 * sizeof(TelemetryRecord);
+const uint32_t flushTimeout = 500;
+const int samplePeriod = 10;
+const uint16_t formatVersion = 1;
+
+pros::Task *Telemetry::sampleTask = nullptr;
+pros::Task *Telemetry::flushTask = nullptr;
+FILE *Telemetry::logFile = nullptr;
+Byte_Ring<32768> Telemetry::ring;
+float Telemetry::armTerms[3] = {0.0f, 0.0f, 0.0f};
+Telemetry::CaptureState Telemetry::captureState;
+std::atomic<bool> Telemetry::stopRequested{false};
+std::atomic<int> Telemetry::runningTasks{0};
+
+#define CHANNEL(field, type) {#field, Telemetry::type, offsetof(TelemetryRecord, field)}
+
+// Channel table written into every log file header
+static const Telemetry::Channel channels[] = {
+    CHANNEL(timestamp, U32),
+    CHANNEL(poseX, F32),
+    CHANNEL(poseY, F32),
+    CHANNEL(poseTheta, F32),
+    CHANNEL(leftVelocity, I16),
+    CHANNEL(rightVelocity, I16),
+    CHANNEL(armVelocity, I16),
+    CHANNEL(intakeVelocity, I16),
+    CHANNEL(leftCurrent, I16),
+    CHANNEL(rightCurrent, I16),
+    CHANNEL(armCurrent, I16),
+    CHANNEL(intakeCurrent, I16),
+    CHANNEL(armP, F32),
+    CHANNEL(armI, F32),
+    CHANNEL(armD, F32),
+    CHANNEL(armAngle, I32),
+    CHANNEL(batteryVoltage, U16),
+    CHANNEL(lateralP, F32),
+    CHANNEL(lateralI, F32),
+    CHANNEL(lateralD, F32),
+    CHANNEL(angularP, F32),
+    CHANNEL(angularI, F32),
+    CHANNEL(angularD, F32),
+};
+
+#undef CHANNEL
+
+/**
+ * @brief Returns the channel table describing TelemetryRecord.
+ */
+const Telemetry::Channel *Telemetry::GetChannels(uint16_t &count) {
+    count = sizeof(channels) / sizeof(channels[0]);
+    return channels;
+}
+
+/**
+ * @brief Returns the size in bytes of a channel value type.
+ */
+uint8_t Telemetry::GetChannelSize(uint8_t type) {
+    return (type == U16 || type == I16) ? 2 : 4;
+}
+
+/**
+ * @brief Opens a new log file and starts the sampling and flush tasks.
+ *
+ * Log files are numbered so that earlier runs are never overwritten.
+ *
+ * @return True if the SD card was available and logging started.
+ */
+bool Telemetry::Start() {
+    if (sampleTask != nullptr || !pros::usd::is_installed()) {
+        return sampleTask != nullptr;
+    }
+
+    logFile = File_Index::OpenNext("telem", ".bin", "wb");
+    if (logFile == nullptr) {
+        return false;
+    }
+
+    ring.Reset();
+    WriteHeader();
+
+    stopRequested = false;
+    runningTasks = 2;
+    sampleTask = new pros::Task(SampleTask, nullptr, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT,
+                                "Telemetry Sample Task");
+    flushTask = new pros::Task(FlushTask, nullptr, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT,
+                               "Telemetry Flush Task");
+    return true;
+}
+
+/**
+ * @brief Stops sampling and writes everything left in the ring buffer.
+ *
+ * The tasks are asked to stop and left to finish their current sample or
+ * write; the flush task writes whatever is left before it exits, so the log
+ * file is only closed once nothing is using it.
+ */
+void Telemetry::Stop() {
+    if (sampleTask == nullptr) return;
+
+    stopRequested = true;
+    while (runningTasks.load() > 0) {
+        pros::delay(5);
+    }
+
+    delete sampleTask;
+    sampleTask = nullptr;
+    delete flushTask;
+    flushTask = nullptr;
+
+    fclose(logFile);
+    logFile = nullptr;
+}
+
+/**
+ * @brief Publishes the latest arm PID terms for the next sample.
+ */
+void Telemetry::SetArmPID(float p, float i, float d) {
+    armTerms[0] = p;
+    armTerms[1] = i;
+    armTerms[2] = d;
+}
+
+/**
+ * @brief Returns how many records were dropped because the buffer was full.
+ */
+uint32_t Telemetry::GetDroppedRecords() {
+    return ring.GetOverflows();
+}
+
+/**
+ * @brief Writes the file header and channel table.
+ */
+void Telemetry::WriteHeader() {
+    const char magic[8] = {'6', '7', '4', '1', 'T', 'L', 'M', '\0'};
+    uint16_t recordSize = sizeof(TelemetryRecord);
+    uint16_t channelCount = sizeof(channels) / sizeof(channels[0]);
+
+    fwrite(magic, sizeof(magic), 1, logFile);
+    fwrite(&formatVersion, sizeof(formatVersion), 1, logFile);
+    fwrite(&recordSize, sizeof(recordSize), 1, logFile);
+    fwrite(&channelCount, sizeof(channelCount), 1, logFile);
+    fwrite(channels, sizeof(channels), 1, logFile);
+}
+
+/**
+ * @brief Sums the current draws reported by a motor group.
+ *
+ * Reads each motor in turn rather than through get_current_draws, which
+ * allocates a vector on every call.
+ */
+static int16_t TotalCurrent(pros::MotorGroup &motors) {
+    int32_t total = 0;
+    for (int i = 0; i < motors.size(); i++) total += motors[i].get_current_draw();
+    return total;
+}
+
+/**
+ * @brief Reads the state lemlib keeps inside its PID controllers.
+ *
+ * lemlib only exposes the controllers, not their terms. Member pointers taken
+ * through a derived class are allowed to name the protected state.
+ */
+struct PID_Reader : lemlib::PID {
+    static constexpr const float lemlib::PID::*gains[3] = {&PID_Reader::kP, &PID_Reader::kI, &PID_Reader::kD};
+    static constexpr float lemlib::PID::*integral = &PID_Reader::integral;
+    static constexpr float lemlib::PID::*error = &PID_Reader::prevError;
+};
+
+/**
+ * @brief Works out the terms of a lemlib PID from its last error and integral.
+ *
+ * lemlib does not keep the error before its last one, so the derivative is
+ * taken from the error at the caller's previous sample.
+ */
+static void ChassisTerms(const lemlib::PID &pid, float &lastError, float &p, float &i, float &d) {
+    float error = pid.*PID_Reader::error;
+    p = pid.*PID_Reader::gains[0] * error;
+    i = pid.*PID_Reader::gains[1] * (pid.*PID_Reader::integral);
+    d = pid.*PID_Reader::gains[2] * (error - lastError);
+    lastError = error;
+}
+
+/**
+ * @brief Fills a record with the current robot state.
+ *
+ * Keeps no state of its own, so the sample task and the serial stream can
+ * both capture records without disturbing each other's derivatives.
+ */
+void Telemetry::Capture(TelemetryRecord &record, CaptureState &state) {
+    lemlib::Pose pose = robotDevices.chassis.getPose();
+
+    record.timestamp = pros::millis();
+    record.poseX = pose.x;
+    record.poseY = pose.y;
+    record.poseTheta = pose.theta;
+    record.leftVelocity = robotDevices.frontLeftMotor.get_actual_velocity();
+    record.rightVelocity = robotDevices.frontRightMotor.get_actual_velocity();
+    record.armVelocity = robotDevices.armMotor1.get_actual_velocity();
+    record.intakeVelocity = robotDevices.intakeMotor.get_actual_velocity();
+    record.leftCurrent = TotalCurrent(robotDevices.leftMotors);
+    record.rightCurrent = TotalCurrent(robotDevices.rightMotors);
+    record.armCurrent = robotDevices.armMotor1.get_current_draw() + robotDevices.armMotor2.get_current_draw();
+    record.intakeCurrent = robotDevices.intakeMotor.get_current_draw();
+    record.armP = armTerms[0];
+    record.armI = armTerms[1];
+    record.armD = armTerms[2];
+    record.armAngle = robotDevices.armRotation.get_position();
+    record.batteryVoltage = pros::battery::get_voltage();
+
+    ChassisTerms(robotDevices.chassis.lateralPID, state.lastLateralError, record.lateralP, record.lateralI,
+                 record.lateralD);
+    ChassisTerms(robotDevices.chassis.angularPID, state.lastAngularError, record.angularP, record.angularI,
+                 record.angularD);
+}
+
+/**
+ * @brief Captures one record of robot state into the ring buffer.
+ *
+ * The record is built on the stack, handed to the flight recorder and copied
+ * into the ring in one write. When the flush task falls behind, the new sample
+ * is dropped rather than overwriting data still waiting for the card.
+ */
+void Telemetry::Sample() {
+    TelemetryRecord record;
+    errno = 0;
+    Capture(record, captureState);
+    Flight_Recorder::NoteErrno(errno);
+    Flight_Recorder::Push(record);
+    ring.Write(&record, sizeof(record));
+}
+
+/**
+ * @brief Writes every published record to the log file.
+ *
+ * Records are written straight out of the ring in at most two contiguous
+ * blocks, one up to the end of the storage and one for the wrap.
+ */
+void Telemetry::Flush() {
+    ring.Drain([](const uint8_t *data, uint32_t size) { fwrite(data, 1, size, logFile); });
+    fflush(logFile);
+}
+
+/**
+ * @brief Samples robot state every sample period.
+ */
+void Telemetry::SampleTask(void *param) {
+    uint32_t now = pros::millis();
+    Loop_Profiler::Profile *loopProfile = Loop_Profiler::Register("Telemetry Sample", 2000);
+
+    while (!stopRequested) {
+        {
+            Loop_Profiler::Scope timer(loopProfile);
+            Sample();
+        }
+        pros::Task::delay_until(&now, samplePeriod);
+    }
+    runningTasks--;
+}
+
+/**
+ * @brief Writes the ring buffer to the SD card in large blocks.
+ *
+ * The card is only touched once a full block is waiting or the flush timeout
+ * has passed, which keeps the number of slow SD writes low.
+ */
+void Telemetry::FlushTask(void *param) {
+    uint32_t lastFlush = pros::millis();
+    while (!stopRequested) {
+        uint32_t pending = ring.Size();
+        if (pending >= flushBlock || (pending > 0 && pros::millis() - lastFlush >= flushTimeout)) {
+            Flush();
+            lastFlush = pros::millis();
+        }
+        pros::delay(50);
+    }
+
+    // Wait for the last sample before writing what is left
+    while (runningTasks.load() > 1) {
+        pros::delay(5);
+    }
+    Flush();
+    runningTasks--;
+}
@@ -0,0 +1,271 @@
+#include "Telemetry_Stream.h"
+#include "Checksum.h"
+#include "pros/apix.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// Stream Constants
+const uint32_t maxFrame = 256;
+const uint32_t minPeriod = 10;
+const uint32_t idlePeriod = 50;
+const uint32_t describeHeader = 5;
+const uint32_t describeEntry = 18;
+
+pros::Task *Telemetry_Stream::receiveTask = nullptr;
+pros::Task *Telemetry_Stream::sendTask = nullptr;
+std::atomic<uint32_t> Telemetry_Stream::channelMask{0};
+std::atomic<uint32_t> Telemetry_Stream::period{0};
+std::atomic<bool> Telemetry_Stream::describePending{false};
+uint32_t Telemetry_Stream::badFrames = 0;
+
+/**
+ * @brief COBS encodes a buffer so that the output contains no zero bytes.
+ *
+ * @return The number of bytes written to out, which must hold size + size / 254 + 1.
+ */
+static uint32_t CobsEncode(const uint8_t *data, uint32_t size, uint8_t *out) {
+    uint32_t write = 1, code = 0;
+    uint8_t run = 1;
+
+    for (uint32_t i = 0; i < size; i++) {
+        if (data[i] != 0) {
+            out[write++] = data[i];
+            run++;
+        }
+        if (data[i] == 0 || run == 0xFF) {
+            out[code] = run;
+            code = write++;
+            run = 1;
+        }
+    }
+
+    out[code] = run;
+    return write;
+}
+
+/**
+ * @brief Decodes a COBS encoded buffer in place.
+ *
+ * @return The decoded size, or 0 if the buffer is malformed.
+ */
+static uint32_t CobsDecode(uint8_t *data, uint32_t size) {
+    uint32_t read = 0, write = 0;
+
+    while (read < size) {
+        uint8_t code = data[read++];
+        if (code == 0 || read + code - 1 > size) return 0;
+
+        for (uint8_t i = 1; i < code; i++) data[write++] = data[read++];
+        if (code != 0xFF && read < size) data[write++] = 0;
+    }
+
+    return write;
+}
+
+/**
+ * @brief Switches the serial link to raw frames and starts the stream tasks.
+ *
+ * PROS normally multiplexes stdout through its own COBS streams. That is
+ * turned off so the host sees our frames directly; any plain text printed in
+ * between simply fails the CRC on the host and is shown as text.
+ */
+void Telemetry_Stream::Start() {
+    if (receiveTask != nullptr) return;
+
+    pros::c::serctl(SERCTL_DISABLE_COBS, nullptr);
+    receiveTask = new pros::Task(ReceiveTask, nullptr, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT,
+                                 "Telemetry Receive Task");
+    sendTask = new pros::Task(SendTask, nullptr, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT,
+                              "Telemetry Send Task");
+}
+
+/**
+ * @brief Stops streaming and returns the serial link to PROS multiplexing.
+ */
+void Telemetry_Stream::Stop() {
+    if (receiveTask != nullptr) {
+        receiveTask->remove();
+        delete receiveTask;
+        receiveTask = nullptr;
+    }
+
+    if (sendTask != nullptr) {
+        sendTask->remove();
+        delete sendTask;
+        sendTask = nullptr;
+    }
+
+    channelMask = 0;
+    pros::c::serctl(SERCTL_ENABLE_COBS, nullptr);
+}
+
+/**
+ * @brief Returns how many received frames failed the CRC check.
+ */
+uint32_t Telemetry_Stream::GetBadFrames() {
+    return badFrames;
+}
+
+/**
+ * @brief Appends the CRC, COBS encodes a frame and writes it to the host.
+ */
+void Telemetry_Stream::SendFrame(const uint8_t *frame, uint32_t size) {
+    uint8_t raw[maxFrame + 2];
+    uint8_t encoded[maxFrame + maxFrame / 254 + 5];
+
+    std::memcpy(raw, frame, size);
+    uint16_t crc = Crc16(frame, size);
+    raw[size] = crc & 0xFF;
+    raw[size + 1] = crc >> 8;
+
+    encoded[0] = 0;
+    uint32_t length = CobsEncode(raw, size + 2, encoded + 1) + 1;
+    encoded[length++] = 0;
+
+    fwrite(encoded, 1, length, stdout);
+    fflush(stdout);
+}
+
+/**
+ * @brief Tells the host the period and layout of the subscribed channels.
+ *
+ * The description is split over as many frames as it takes. Each frame
+ * carries the total number of subscribed channels and the position of its
+ * first entry, so the host knows when it has the whole layout.
+ */
+void Telemetry_Stream::SendDescription(uint32_t mask, uint32_t period) {
+    uint16_t count;
+    const Telemetry::Channel *channels = Telemetry::GetChannels(count);
+
+    uint8_t total = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        if (mask & (1u << i)) total++;
+    }
+
+    uint8_t frame[maxFrame];
+    frame[0] = DESCRIBE;
+    frame[1] = period & 0xFF;
+    frame[2] = period >> 8;
+    frame[3] = total;
+    frame[4] = 0;
+    uint32_t size = describeHeader;
+    uint8_t described = 0;
+
+    for (uint16_t i = 0; i < count; i++) {
+        if (!(mask & (1u << i))) continue;
+
+        // Start the next frame once this one is full
+        if (size + describeEntry > maxFrame) {
+            SendFrame(frame, size);
+            frame[4] = described;
+            size = describeHeader;
+        }
+
+        std::memcpy(frame + size, channels[i].name, sizeof(channels[i].name));
+        frame[size + 16] = channels[i].type;
+        frame[size + 17] = i;
+        size += describeEntry;
+        described++;
+    }
+
+    SendFrame(frame, size);
+}
+
+/**
+ * @brief Applies a frame received from the host.
+ *
+ * A subscription always includes the timestamp channel so the host can line
+ * samples up, and a mask of zero stops the stream.
+ */
+void Telemetry_Stream::HandleFrame(const uint8_t *frame, uint32_t size) {
+    if (size < 2 || Crc16(frame, size - 2) != (frame[size - 2] | frame[size - 1] << 8)) {
+        badFrames++;
+        return;
+    }
+
+    if (frame[0] == SUBSCRIBE && size == 1 + 6 + 2) {
+        uint32_t mask;
+        uint16_t requestedPeriod;
+        std::memcpy(&mask, frame + 1, sizeof(mask));
+        std::memcpy(&requestedPeriod, frame + 5, sizeof(requestedPeriod));
+
+        // Only describe channels that exist, so the host's layout matches the DATA frames
+        uint16_t count;
+        Telemetry::GetChannels(count);
+        uint32_t existing = count >= 32 ? 0xFFFFFFFFu : (1u << count) - 1;
+
+        period = std::max<uint32_t>(requestedPeriod, minPeriod);
+        channelMask = mask ? ((mask | 1u) & existing) : 0;
+        describePending = true;
+    }
+}
+
+/**
+ * @brief Collects bytes from the host into frames between zero delimiters.
+ */
+void Telemetry_Stream::ReceiveTask(void *param) {
+    uint8_t buffer[maxFrame];
+    uint32_t size = 0;
+
+    while (true) {
+        int byte = getchar();
+        if (byte == EOF) {
+            pros::delay(idlePeriod);
+            continue;
+        }
+
+        if (byte != 0) {
+            if (size < maxFrame) buffer[size++] = byte;
+            continue;
+        }
+
+        if (size > 0) {
+            uint32_t decoded = CobsDecode(buffer, size);
+            if (decoded > 0) HandleFrame(buffer, decoded);
+            else badFrames++;
+        }
+        size = 0;
+    }
+}
+
+/**
+ * @brief Sends the subscribed channels every subscription period.
+ */
+void Telemetry_Stream::SendTask(void *param) {
+    uint16_t count;
+    const Telemetry::Channel *channels = Telemetry::GetChannels(count);
+    Telemetry::CaptureState captureState;
+    uint32_t now = pros::millis();
+
+    while (true) {
+        // Clear the flag before reading the mask, so a subscription that lands in between is described next cycle
+        bool describe = describePending.exchange(false);
+        uint32_t mask = channelMask.load();
+        if (describe) {
+            SendDescription(mask, period.load());
+        }
+
+        if (mask == 0) {
+            pros::delay(idlePeriod);
+            now = pros::millis();
+            continue;
+        }
+
+        TelemetryRecord record;
+        Telemetry::Capture(record, captureState);
+
+        uint8_t frame[maxFrame];
+        uint32_t size = 1;
+        frame[0] = DATA;
+        for (uint16_t i = 0; i < count; i++) {
+            if (!(mask & (1u << i))) continue;
+            uint8_t width = Telemetry::GetChannelSize(channels[i].type);
+            std::memcpy(frame + size, reinterpret_cast<const uint8_t *>(&record) + channels[i].offset, width);
+            size += width;
+        }
+
+        SendFrame(frame, size);
+        pros::Task::delay_until(&now, period.load());
+    }
+}
@@ -0,0 +1,142 @@
+#include "Thermal_Model.h"
+#include "Controller_Display.h"
+#include <algorithm>
+#include <cmath>
+
+// Thermal Constants (degrees C / seconds / amps)
+const double ambientTemperature = 25.0;
+const double limitTemperature = 55.0;
+const double heatingRate = 0.012;
+const double coolingTime = 600.0;
+const double sensorStep = 5.0;
+const double correctionRate = 0.05;
+const double currentSmoothing = 0.1;
+const double derateHeadroom = 120.0;
+const double minDerate = 0.6;
+const int maxMotors = 6;
+const uint32_t thermalPeriod = 100;
+const int displayEvery = 10;
+
+pros::Task *Thermal_Model::thermalTask = nullptr;
+double Thermal_Model::derate[Power_Governor::GROUP_COUNT] = {1.0, 1.0, 1.0};
+double Thermal_Model::headroom[Power_Governor::GROUP_COUNT] = {maxHeadroom, maxHeadroom, maxHeadroom};
+double Thermal_Model::temperature[Power_Governor::GROUP_COUNT] = {ambientTemperature, ambientTemperature,
+                                                                  ambientTemperature};
+
+// Per-motor state, indexed by group and then by the motor's place in the group
+static double estimate[Power_Governor::GROUP_COUNT][maxMotors];
+static double squaredCurrent[Power_Governor::GROUP_COUNT][maxMotors];
+static bool seeded = false;
+
+/**
+ * @brief Starts the thermal model task if it is not already running.
+ */
+void Thermal_Model::Start() {
+    if (thermalTask == nullptr) {
+        thermalTask = new pros::Task(ThermalTask, nullptr, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT,
+                                     "Thermal Model Task");
+    }
+}
+
+/**
+ * @brief Returns the output fraction a group should be limited to.
+ */
+double Thermal_Model::GetDerate(Power_Governor::Group group) {
+    return derate[group];
+}
+
+/**
+ * @brief Returns the predicted seconds until the hottest motor of a group reaches its limit.
+ */
+double Thermal_Model::GetHeadroom(Power_Governor::Group group) {
+    return headroom[group];
+}
+
+/**
+ * @brief Returns the estimated temperature of the hottest motor in a group.
+ */
+double Thermal_Model::GetTemperature(Power_Governor::Group group) {
+    return temperature[group];
+}
+
+/**
+ * @brief Predicts how long a motor can hold a load before reaching the limit.
+ *
+ * With constant current the model settles exponentially towards a steady
+ * temperature. If that steady temperature is below the limit the motor never
+ * gets there; otherwise the crossing time comes straight from the exponential.
+ *
+ * @param current The motor's estimated temperature.
+ * @param load The motor's mean squared current, in amps squared.
+ */
+static double TimeToLimit(double current, double load) {
+    if (current >= limitTemperature) return 0.0;
+
+    double steady = ambientTemperature + heatingRate * load * coolingTime;
+    if (steady <= limitTemperature) return Thermal_Model::maxHeadroom;
+
+    double time = -coolingTime * std::log((limitTemperature - steady) / (current - steady));
+    return std::min(time, Thermal_Model::maxHeadroom);
+}
+
+/**
+ * @brief Advances every motor's estimate and recomputes the group derating.
+ *
+ * @param dt Time since the last update, in seconds.
+ */
+void Thermal_Model::Update(double dt) {
+    for (int group = 0; group < Power_Governor::GROUP_COUNT; group++) {
+        int count;
+        pros::Motor *const *motors = Power_Governor::GetMotors(static_cast<Power_Governor::Group>(group), count);
+
+        double hottest = 0.0;
+        double shortest = maxHeadroom;
+
+        for (int i = 0; i < count; i++) {
+            double amps = motors[i]->get_current_draw() / 1000.0;
+            double reported = motors[i]->get_temperature();
+            if (!seeded) estimate[group][i] = std::max(reported, ambientTemperature);
+
+            // Integrate heating from current and cooling towards ambient
+            squaredCurrent[group][i] += (amps * amps - squaredCurrent[group][i]) * currentSmoothing;
+            double &temp = estimate[group][i];
+            temp += (heatingRate * amps * amps - (temp - ambientTemperature) / coolingTime) * dt;
+
+            // Only trust the coarse sensor when the estimate has left its step
+            if (std::fabs(temp - reported) > sensorStep / 2) {
+                temp += (reported - temp) * correctionRate;
+            }
+
+            hottest = std::max(hottest, temp);
+            shortest = std::min(shortest, TimeToLimit(temp, squaredCurrent[group][i]));
+        }
+
+        temperature[group] = hottest;
+        headroom[group] = shortest;
+
+        // Ease off linearly as the headroom runs out instead of hitting the firmware cliff
+        double remaining = std::clamp(shortest / derateHeadroom, 0.0, 1.0);
+        derate[group] = minDerate + (1.0 - minDerate) * remaining;
+    }
+
+    seeded = true;
+}
+
+/**
+ * @brief Updates the model every thermal period and shows the headroom to the driver.
+ */
+void Thermal_Model::ThermalTask(void *param) {
+    uint32_t now = pros::millis();
+    int iteration = 0;
+
+    while (true) {
+        Update(thermalPeriod / 1000.0);
+
+        if (++iteration % displayEvery == 0) {
+            Controller_Display::Print(2, "Drv%3.0fs Arm%3.0fs", headroom[Power_Governor::DRIVE],
+                                      headroom[Power_Governor::ARM]);
+        }
+
+        pros::Task::delay_until(&now, thermalPeriod);
+    }
+}
@@ -0,0 +1,137 @@
+#include "Robot_Config.h"
+#include "Traction_Control.h"
+#include "Loop_Profiler.h"
+#include "Power_Governor.h"
+#include <algorithm>
+#include <cmath>
+
+extern Robot_Config robotDevices;
+
+pros::Task *Traction_Control::tractionTask = nullptr;
+double Traction_Control::slip = 0.0;
+double Traction_Control::scale = 1.0;
+double Traction_Control::lastGroundDistance = 0.0;
+uint64_t Traction_Control::lastSampleTime = 0;
+
+// Traction Constants
+const double motorCartridgeRPM = 600.0;
+const double slipLimit = 0.15;
+const double minWheelSpeed = 6.0;
+const double backOffGain = 1.5;
+const double recoverRate = 0.04;
+const double minScale = 0.4;
+const int tractionPeriod = 10;
+
+/**
+ * @brief Starts the traction control task if it is not already running.
+ */
+void Traction_Control::Start() {
+    if (tractionTask == nullptr) {
+        lastGroundDistance = robotDevices.vertical_tracking_wheel.getDistanceTraveled();
+        lastSampleTime = pros::micros();
+        tractionTask = new pros::Task(TractionTask, nullptr, "Traction Control Task");
+    }
+}
+
+/**
+ * @brief Stops the traction control task and releases the drive output.
+ */
+void Traction_Control::Stop() {
+    if (tractionTask != nullptr) {
+        tractionTask->remove();
+        delete tractionTask;
+        tractionTask = nullptr;
+    }
+
+    slip = 0.0;
+    scale = 1.0;
+    Power_Governor::SetTractionScale(scale);
+}
+
+/**
+ * @brief Returns the most recent slip ratio of the drive wheels.
+ */
+double Traction_Control::GetSlip() {
+    return slip;
+}
+
+/**
+ * @brief Returns the drive scale currently requested by traction control.
+ */
+double Traction_Control::GetScale() {
+    return scale;
+}
+
+/**
+ * @brief Averages the velocities reported by a motor group.
+ *
+ * Reads each motor in turn rather than through get_actual_velocities, which
+ * allocates a vector on every call.
+ *
+ * @param motors The motor group to read.
+ * @return The mean motor velocity in RPM.
+ */
+static double AverageVelocity(pros::MotorGroup &motors) {
+    int count = motors.size();
+    if (count == 0) return 0.0;
+
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) sum += motors[i].get_actual_velocity();
+    return sum / count;
+}
+
+/**
+ * @brief Estimates wheel slip and adjusts the requested drive scale.
+ *
+ * Averaging the left and right side cancels out turning, which leaves the
+ * forward speed of the powered wheels. Slip is only measured while the wheels
+ * are moving fast enough for the ratio to be meaningful, and only when the
+ * wheels are outrunning the ground rather than being dragged by it.
+ */
+void Traction_Control::Update() {
+    // Ground speed from the unpowered vertical tracking wheel, over the measured time between samples
+    uint64_t sampleTime = pros::micros();
+    if (sampleTime == lastSampleTime) return;
+
+    double groundDistance = robotDevices.vertical_tracking_wheel.getDistanceTraveled();
+    double groundSpeed = (groundDistance - lastGroundDistance) * 1e6 / (sampleTime - lastSampleTime);
+    lastGroundDistance = groundDistance;
+    lastSampleTime = sampleTime;
+
+    // Powered wheel speed from the integrated motor encoders
+    double motorRPM = (AverageVelocity(robotDevices.leftMotors) + AverageVelocity(robotDevices.rightMotors)) / 2.0;
+    double wheelRPM = motorRPM * robotDevices.drivetrain.rpm / motorCartridgeRPM;
+    double wheelSpeed = wheelRPM * M_PI * robotDevices.drivetrain.wheelDiameter / 60.0;
+
+    if (std::fabs(wheelSpeed) < minWheelSpeed) {
+        slip = 0.0;
+    } else {
+        double excess = std::fabs(wheelSpeed) - std::copysign(groundSpeed, wheelSpeed);
+        slip = std::clamp(excess / std::fabs(wheelSpeed), 0.0, 1.0);
+    }
+
+    // Back off in proportion to the excess slip, then recover slowly once it grips
+    if (slip > slipLimit) {
+        scale -= backOffGain * (slip - slipLimit) * scale;
+    } else {
+        scale += recoverRate;
+    }
+    scale = std::clamp(scale, minScale, 1.0);
+
+    Power_Governor::SetTractionScale(scale);
+}
+
+/**
+ * @brief Background task that checks for wheel slip every traction period.
+ */
+void Traction_Control::TractionTask(void *param) {
+    Loop_Profiler::Profile *loopProfile = Loop_Profiler::Register("Traction Control", 2000);
+
+    while (true) {
+        {
+            Loop_Profiler::Scope timer(loopProfile);
+            Update();
+        }
+        pros::delay(tractionPeriod);
+    }
+}
@@ -0,0 +1,387 @@
+#include "Tuning_Console.h"
+#include "Brain_UI.h"
+#include "Config_Store.h"
+#include "Robot_Config.h"
+#include "Arm_Control.h"
+#include "Command_Scheduler.h"
+#include "Byte_Ring.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+extern Robot_Config robotDevices;
+
+// Console Constants
+const uint32_t samplePeriod = 20;
+const int chartEvery = 5;
+const uint32_t recordTime = 3000;
+const int chartPoints = recordTime / samplePeriod;
+const int stepTimeout = 3000;
+const double gainScale = 1000.0;
+const double adjustRatio = 1.1;
+const double maxSteps[Tuning_Console::TARGET_COUNT] = {48.0, 180.0, 360.0};
+const char *stepUnits[Tuning_Console::TARGET_COUNT] = {"in", "deg", "deg"};
+
+static const char *targetMap[] = {"Lateral", "Angular", "Arm", ""};
+static const char *gainNames[3] = {"kP", "kI", "kD"};
+
+lv_obj_t *Tuning_Console::screen = nullptr;
+lv_obj_t *Tuning_Console::spinboxes[3] = {nullptr, nullptr, nullptr};
+lv_obj_t *Tuning_Console::slider = nullptr;
+lv_obj_t *Tuning_Console::stepLabel = nullptr;
+lv_obj_t *Tuning_Console::statusLabel = nullptr;
+lv_obj_t *Tuning_Console::chart = nullptr;
+lv_chart_series_t *Tuning_Console::setpointSeries = nullptr;
+lv_chart_series_t *Tuning_Console::measuredSeries = nullptr;
+pros::Task *Tuning_Console::sampleTask = nullptr;
+Tuning_Console::StepCommand Tuning_Console::stepCommand;
+Tuning_Console::Target Tuning_Console::target = LATERAL;
+
+/**
+ * @brief One point of a test step's response.
+ */
+struct Sample {
+    float setpoint;
+    float measured;
+};
+
+// Samples flow from the sample task to the chart's LVGL task through this ring; its
+// size is a multiple of sizeof(Sample), so a drained span never splits a sample
+static Byte_Ring<1024> samples;
+static_assert(1024 % sizeof(Sample) == 0, "Tuning samples must not wrap mid-sample");
+
+// State of the running test step, shared by the UI, the scheduler and the sample task
+static std::atomic<bool> stepPending{false};
+static std::atomic<bool> drivetrainHeld{false};
+static std::atomic<bool> cancelPending{false};
+static std::atomic<bool> recording{false};
+static uint32_t stepStart = 0;
+static float stepSize = 0.0f;
+static lemlib::Pose startPose(0, 0, 0);
+
+/**
+ * @brief Returns the stored gains of a tuning target.
+ */
+static float *GetGains(Tuning_Console::Target target) {
+    StoredConfig &config = Config_Store::Get();
+    switch (target) {
+        case Tuning_Console::LATERAL: return config.lateralGains;
+        case Tuning_Console::ANGULAR: return config.angularGains;
+        default: return config.armGains;
+    }
+}
+
+/**
+ * @brief Creates a small text button with an action.
+ */
+static lv_obj_t *CreateButton(lv_obj_t *parent, const char *text, lv_coord_t x, lv_coord_t y, lv_coord_t width,
+                              lv_action_t action, int id = 0) {
+    lv_obj_t *button = lv_btn_create(parent, NULL);
+    lv_obj_set_size(button, width, 36);
+    lv_obj_set_pos(button, x, y);
+    lv_obj_set_free_num(button, id);
+    lv_btn_set_action(button, LV_BTN_ACTION_CLICK, action);
+
+    lv_obj_t *label = lv_label_create(button, NULL);
+    lv_label_set_text(label, text);
+    return button;
+}
+
+/**
+ * @brief Switches the Brain screen to the tuning console, building it on first use.
+ */
+void Tuning_Console::Show() {
+    if (screen == nullptr) {
+        Build();
+    }
+    lv_scr_load(screen);
+
+    if (sampleTask == nullptr) {
+        sampleTask = new pros::Task(SampleTask, nullptr, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT,
+                                    "Tuning Console Task");
+    }
+}
+
+/**
+ * @brief Creates the console's controls and chart.
+ */
+void Tuning_Console::Build() {
+    screen = lv_obj_create(NULL, NULL);
+
+    // Choose which controller to tune
+    lv_obj_t *targets = lv_btnm_create(screen, NULL);
+    lv_btnm_set_map(targets, targetMap);
+    lv_btnm_set_toggle(targets, true, target);
+    lv_btnm_set_action(targets, TargetAction);
+    lv_obj_set_size(targets, 300, 40);
+    lv_obj_set_pos(targets, 10, 5);
+
+    CreateButton(screen, "Back", 390, 7, 80, BackAction);
+
+    // One row per gain: name, decrease, value, increase
+    for (int row = 0; row < 3; row++) {
+        lv_coord_t y = 55 + row * 45;
+
+        lv_obj_t *name = lv_label_create(screen, NULL);
+        lv_label_set_text(name, gainNames[row]);
+        lv_obj_set_pos(name, 10, y + 8);
+
+        CreateButton(screen, "-", 40, y, 40, AdjustAction, row * 2);
+
+        spinboxes[row] = lv_spinbox_create(screen, NULL);
+        lv_spinbox_set_digit_format(spinboxes[row], 5, 2);
+        lv_spinbox_set_range(spinboxes[row], 0, 99999);
+        lv_obj_set_size(spinboxes[row], 100, 36);
+        lv_obj_set_pos(spinboxes[row], 85, y);
+
+        CreateButton(screen, "+", 190, y, 40, AdjustAction, row * 2 + 1);
+    }
+
+    // Size of the test step
+    stepLabel = lv_label_create(screen, NULL);
+    lv_obj_set_pos(stepLabel, 10, 190);
+
+    slider = lv_slider_create(screen, NULL);
+    lv_slider_set_range(slider, 0, 100);
+    lv_slider_set_value(slider, 50);
+    lv_slider_set_action(slider, SliderAction);
+    lv_obj_set_size(slider, 220, 20);
+    lv_obj_set_pos(slider, 10, 212);
+
+    // Setpoint against measured response, scaled so the setpoint sits at 100 and
+    // fed by an LVGL task, which runs on the same task as the rest of LVGL
+    chart = lv_chart_create(screen, NULL);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(chart, chartPoints);
+    lv_chart_set_range(chart, -20, 120);
+    lv_chart_set_div_line_count(chart, 3, 0);
+    lv_obj_set_size(chart, 225, 120);
+    lv_obj_set_pos(chart, 245, 55);
+    setpointSeries = lv_chart_add_series(chart, LV_COLOR_RED);
+    measuredSeries = lv_chart_add_series(chart, LV_COLOR_LIME);
+    lv_task_create(ChartTask, samplePeriod * chartEvery, LV_TASK_PRIO_LOW, nullptr);
+
+    statusLabel = lv_label_create(screen, NULL);
+    lv_label_set_text(statusLabel, "");
+    lv_obj_set_pos(statusLabel, 245, 180);
+
+    CreateButton(screen, "Run", 245, 200, 100, RunAction);
+    CreateButton(screen, "Save", 370, 200, 100, SaveAction);
+
+    LoadGains();
+    ShowStep();
+}
+
+/**
+ * @brief Shows the selected target's stored gains in the spinboxes.
+ */
+void Tuning_Console::LoadGains() {
+    const float *gains = GetGains(target);
+    for (int row = 0; row < 3; row++) {
+        lv_spinbox_set_value(spinboxes[row], std::lround(gains[row] * gainScale));
+    }
+}
+
+/**
+ * @brief Updates the step label from the slider.
+ */
+void Tuning_Console::ShowStep() {
+    char text[32];
+    snprintf(text, sizeof(text), "Step %.1f %s", lv_slider_get_value(slider) / 100.0 * maxSteps[target],
+             stepUnits[target]);
+    lv_label_set_text(stepLabel, text);
+}
+
+/**
+ * @brief Starts a test step on the selected controller with the edited gains.
+ *
+ * Arm steps start straight away through the arm's own command. Chassis steps
+ * schedule stepCommand to take the drivetrain from the driver, and the sample
+ * task starts the motion once the command holds it.
+ */
+void Tuning_Console::RunStep() {
+    if (stepPending || recording || robotDevices.chassis.isInMotion()) {
+        lv_label_set_text(statusLabel, "Busy");
+        return;
+    }
+
+    stepSize = lv_slider_get_value(slider) / 100.0 * maxSteps[target];
+
+    lv_chart_init_points(chart, setpointSeries, 0);
+    lv_chart_init_points(chart, measuredSeries, 0);
+    lv_label_set_text(statusLabel, "Running");
+
+    if (target == ARM) {
+        Arm_Control::StopArmPID();
+        Arm_Control::StartArmPID(stepSize * 100);
+        stepStart = pros::millis();
+        recording = true;
+        return;
+    }
+
+    stepPending = true;
+    Command_Scheduler::Schedule(&stepCommand);
+}
+
+/**
+ * @brief Starts the pending chassis step from the current pose.
+ *
+ * Lateral steps drive forward from the current pose and angular steps turn
+ * from the current heading. lemlib's motion calls block for a few cycles, so
+ * this runs on the sample task rather than the scheduler.
+ */
+void Tuning_Console::StartMotion() {
+    Config_Store::ApplyChassisGains();
+    startPose = robotDevices.chassis.getPose();
+
+    if (target == LATERAL) {
+        double heading = startPose.theta * M_PI / 180.0;
+        robotDevices.chassis.moveToPoint(startPose.x + stepSize * std::sin(heading),
+                                         startPose.y + stepSize * std::cos(heading), stepTimeout);
+    } else {
+        robotDevices.chassis.turnToHeading(startPose.theta + stepSize, stepTimeout);
+    }
+}
+
+void Tuning_Console::StepCommand::Initialize() {
+    drivetrainHeld = true;
+}
+
+bool Tuning_Console::StepCommand::IsFinished() {
+    return !stepPending && !recording;
+}
+
+/**
+ * @brief Releases the drivetrain, stopping the step if another command took it.
+ *
+ * Cancelling a lemlib motion may block, so the sample task does it.
+ */
+void Tuning_Console::StepCommand::End(bool interrupted) {
+    drivetrainHeld = false;
+    if (interrupted) {
+        cancelPending = stepPending.exchange(false) || recording.exchange(false);
+    }
+}
+
+/**
+ * @brief Selects the controller to tune.
+ */
+lv_res_t Tuning_Console::TargetAction(lv_obj_t *btnm, const char *text) {
+    for (int i = 0; i < TARGET_COUNT; i++) {
+        if (strcmp(text, targetMap[i]) == 0) target = static_cast<Target>(i);
+    }
+    LoadGains();
+    ShowStep();
+    return LV_RES_OK;
+}
+
+/**
+ * @brief Nudges a gain by ten percent, or by the smallest step when it is zero.
+ */
+lv_res_t Tuning_Console::AdjustAction(lv_obj_t *btn) {
+    int id = lv_obj_get_free_num(btn);
+    int row = id / 2;
+    bool increase = id % 2 == 1;
+
+    int32_t value = lv_spinbox_get_value(spinboxes[row]);
+    int32_t adjusted = std::lround(increase ? value * adjustRatio : value / adjustRatio);
+    if (adjusted == value) adjusted += increase ? 1 : -1;
+    lv_spinbox_set_value(spinboxes[row], adjusted);
+
+    GetGains(target)[row] = lv_spinbox_get_value(spinboxes[row]) / gainScale;
+    return LV_RES_OK;
+}
+
+lv_res_t Tuning_Console::SliderAction(lv_obj_t *slider) {
+    ShowStep();
+    return LV_RES_OK;
+}
+
+lv_res_t Tuning_Console::RunAction(lv_obj_t *btn) {
+    RunStep();
+    return LV_RES_OK;
+}
+
+/**
+ * @brief Writes the edited gains of every target to the SD card.
+ */
+lv_res_t Tuning_Console::SaveAction(lv_obj_t *btn) {
+    lv_label_set_text(statusLabel, Config_Store::Save() ? "Saved" : "Save failed");
+    return LV_RES_OK;
+}
+
+lv_res_t Tuning_Console::BackAction(lv_obj_t *btn) {
+    Brain_UI::DisplayAutonSelectorUI();
+    return LV_RES_OK;
+}
+
+/**
+ * @brief Starts pending chassis steps and samples the running one.
+ *
+ * Sampling runs every sample period so the response is captured evenly. The
+ * samples only go into the ring; ChartTask moves them onto the chart.
+ */
+void Tuning_Console::SampleTask(void *param) {
+    uint32_t now = pros::millis();
+
+    while (true) {
+        if (cancelPending.exchange(false)) {
+            robotDevices.chassis.cancelMotion();
+        }
+
+        if (stepPending && drivetrainHeld) {
+            StartMotion();
+            stepStart = pros::millis();
+            recording = true;
+            stepPending = false;
+        }
+
+        if (recording) {
+            Sample sample;
+            sample.setpoint = stepSize;
+
+            lemlib::Pose pose = robotDevices.chassis.getPose();
+            switch (target) {
+                case LATERAL: sample.measured = pose.distance(startPose); break;
+                case ANGULAR: sample.measured = pose.theta - startPose.theta; break;
+                default: sample.measured = Arm_Control::GetPosition() / 100.0; break;
+            }
+            samples.Write(&sample, sizeof(sample));
+
+            if (pros::millis() - stepStart >= recordTime) recording = false;
+        }
+
+        pros::Task::delay_until(&now, samplePeriod);
+    }
+}
+
+/**
+ * @brief Moves recorded samples onto the chart. Runs as an LVGL task.
+ *
+ * The chart is only fed and redrawn every few samples, and not at all while
+ * another screen is shown.
+ */
+void Tuning_Console::ChartTask(void *param) {
+    static bool wasRunning = false;
+
+    if (lv_scr_act() != screen) return;
+
+    float scale = std::fabs(stepSize) > 0.01f ? 100.0f / stepSize : 0.0f;
+    bool added = false;
+
+    samples.Drain([&](const uint8_t *data, uint32_t size) {
+        for (uint32_t offset = 0; offset + sizeof(Sample) <= size; offset += sizeof(Sample)) {
+            Sample sample;
+            memcpy(&sample, data + offset, sizeof(sample));
+            lv_chart_set_next(chart, setpointSeries, std::lround(sample.setpoint * scale));
+            lv_chart_set_next(chart, measuredSeries, std::lround(sample.measured * scale));
+            added = true;
+        }
+    });
+    if (added) lv_chart_refresh(chart);
+
+    bool running = stepPending || recording;
+    if (wasRunning && !running) lv_label_set_text(statusLabel, "Done");
+    wasRunning = running;
+}
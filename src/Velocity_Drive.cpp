@@ -0,0 +1,148 @@
+#include "Robot_Config.h"
+#include "Velocity_Drive.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+extern Robot_Config robotDevices;
+
+// Velocity Constants (motor RPM / mV)
+// Full stick asks for about 87% of the 600 RPM free speed: kS + kV * 520 is
+// about 10.5 V, which a sagging battery can still supply under load, so the
+// loop keeps some headroom for the PID and the heading correction
+const double maxTargetRPM = 520.0;
+const double maxAcceleration = 2400.0;
+const double kS = 600.0;
+const double kV = 19.0;
+const double kA = 0.4;
+const double kP = 12.0;
+const double kI = 0.5;
+const double kD = 0.0;
+const double windupRange = 40.0;
+const double maxVoltage = 12000.0;
+const int matchBand = 8;
+const int holdDeadband = 10;
+const double headingGain = 4.0;
+const int drivePeriod = 10;
+
+bool Velocity_Drive::running = false;
+double Velocity_Drive::leftTarget = 0.0;
+double Velocity_Drive::rightTarget = 0.0;
+bool Velocity_Drive::holdingHeading = false;
+double Velocity_Drive::heldHeading = 0.0;
+lemlib::PID Velocity_Drive::leftPID(kP, kI, kD, windupRange, true);
+lemlib::PID Velocity_Drive::rightPID(kP, kI, kD, windupRange, true);
+
+/**
+ * @brief Switches driver control to the velocity loop.
+ */
+void Velocity_Drive::Start() {
+    if (!running) {
+        leftTarget = 0.0;
+        rightTarget = 0.0;
+        holdingHeading = false;
+        leftPID.reset();
+        rightPID.reset();
+        running = true;
+    }
+}
+
+/**
+ * @brief Switches the velocity loop off and stops the drive motors.
+ */
+void Velocity_Drive::Stop() {
+    if (running) {
+        running = false;
+        robotDevices.leftMotors.move_voltage(0);
+        robotDevices.rightMotors.move_voltage(0);
+    }
+}
+
+/**
+ * @brief Returns true while the velocity loop owns the drive motors.
+ */
+bool Velocity_Drive::IsRunning() {
+    return running;
+}
+
+/**
+ * @brief Averages the velocities reported by a motor group.
+ *
+ * @param motors The motor group to read.
+ * @return The mean motor velocity in RPM.
+ */
+static double AverageVelocity(pros::MotorGroup &motors) {
+    int count = motors.size();
+    if (count == 0) return 0.0;
+
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) sum += motors[i].get_actual_velocity();
+    return sum / count;
+}
+
+/**
+ * @brief Runs one side's feedforward and PID and sends the result as a voltage.
+ *
+ * The feedforward covers the voltage a free-spinning side needs for the target
+ * speed, so the PID only has to make up for load and battery sag.
+ *
+ * @param target The ramped velocity target, in motor RPM.
+ * @param acceleration How fast the target moved this period, in RPM per second.
+ */
+void Velocity_Drive::DriveSide(pros::MotorGroup &motors, lemlib::PID &pid, double target, double acceleration) {
+    double voltage = 0.0;
+
+    if (target != 0.0) {
+        double sign = target > 0.0 ? 1.0 : -1.0;
+        voltage = kS * sign + kV * target + kA * acceleration;
+        voltage += pid.update(target - AverageVelocity(motors));
+    } else {
+        // Let the motors coast at rest instead of fighting encoder noise
+        pid.reset();
+    }
+
+    voltage = std::clamp(voltage, -maxVoltage, maxVoltage);
+    motors.move_voltage(voltage);
+}
+
+/**
+ * @brief Ramps the targets, applies the heading hold and drives both sides.
+ */
+void Velocity_Drive::Update(int left, int right) {
+    double leftWanted = left / 127.0 * maxTargetRPM;
+    double rightWanted = right / 127.0 * maxTargetRPM;
+
+    // Hold the heading from the moment both sticks are pushed together
+    bool matched = std::abs(left - right) <= matchBand && std::abs(left + right) / 2 > holdDeadband;
+    if (matched) {
+        double heading = robotDevices.chassis.getPose().theta;
+        if (!holdingHeading) {
+            heldHeading = heading;
+            holdingHeading = true;
+        }
+
+        double average = (leftWanted + rightWanted) / 2.0;
+        double correction = headingGain * lemlib::angleError(heldHeading, heading, false);
+        leftWanted = average + correction;
+        rightWanted = average - correction;
+
+        // Slow both sides rather than clip one, so the correction still turns the robot at full speed
+        double fastest = std::max(std::fabs(leftWanted), std::fabs(rightWanted));
+        if (fastest > maxTargetRPM) {
+            leftWanted *= maxTargetRPM / fastest;
+            rightWanted *= maxTargetRPM / fastest;
+        }
+    } else {
+        holdingHeading = false;
+    }
+
+    // Limit how fast each side's target can change
+    double step = maxAcceleration * drivePeriod / 1000.0;
+    double leftStep = std::clamp(leftWanted - leftTarget, -step, step);
+    double rightStep = std::clamp(rightWanted - rightTarget, -step, step);
+    leftTarget += leftStep;
+    rightTarget += rightStep;
+
+    DriveSide(robotDevices.leftMotors, leftPID, leftTarget, leftStep * 1000.0 / drivePeriod);
+    DriveSide(robotDevices.rightMotors, rightPID, rightTarget, rightStep * 1000.0 / drivePeriod);
+}
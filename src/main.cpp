@@ -4,6 +4,23 @@
 #include "Robot.h"
 #include "Autonomous_Manager.h"
 #include "Robot_Config.h"
+#include "Power_Governor.h"
+#include "Traction_Control.h"
+#include "Telemetry.h"
+#include "Deferred_Log.h"
+#include "Telemetry_Stream.h"
+#include "Loop_Profiler.h"
+#include "Task_Monitor.h"
+#include "Match_Recorder.h"
+#include "Flight_Recorder.h"
+#include "Thermal_Model.h"
+#include "Micro_Benchmark.h"
+#include "Field_Map.h"
+#include "Config_Store.h"
+#include "Controller_Display.h"
+#include "Velocity_Drive.h"
+#include "Driver_Macro.h"
+#include "Command_Scheduler.h"
 #include "pros/optical.hpp"
 #include <thread>
 
@@ -16,58 +33,120 @@ Brain_UI ui;
 Autonomous_Manager autonManager(robot);
 Controller master(pros::E_CONTROLLER_MASTER);
 
+/*** @brief Controller input for the current driver control iteration, live or replayed */
+ControllerSnapshot input;
+
 /*** @brief Runs when robot is disabled by VEX Field Controller */
 void disabled() {   
+    // The match routine runs on the scheduler task, so it has to be stopped explicitly
+    autonManager.Stop();
+
+    // Dump loop timing from the period that just ended
+    Loop_Profiler::PrintReport();
+    Task_Monitor::PrintReport();
+
     // Display Autonomous Selector UI and calibrate sensors
     ui.DisplayAutonSelectorUI();
     robotDevices.chassis.calibrate(); 
 }
 
 /*** @brief Initialize function. Runs on program startup */
-void initialize() {}
+void initialize() {
+    // Format log messages on a background task instead of the caller
+    Deferred_Log::Start();
+    // Restore the autonomous selection and tuned gains from the SD card
+    Config_Store::Load();
+    ui.selectedAuton = Config_Store::Get().selectedAuton;
+    autonManager.Prepare(ui.selectedAuton);
+    Config_Store::ApplyChassisGains();
+    Config_Store::ApplyDriveCurves();
+    // Send controller screen updates and rumbles at the rate the controller accepts
+    Controller_Display::Start(master);
+    // Predict motor temperatures so the governor can derate smoothly
+    Thermal_Model::Start();
+    // Run subsystem commands and driver control on one task
+    Command_Scheduler::Start();
+    // Share the current budget between the drive, arm and intake
+    Power_Governor::Start();
+    // Back off drive output when the wheels spin faster than the ground
+    Traction_Control::Start();
+    // Log control-loop state to the SD card when one is inserted
+    Telemetry::Start();
+
+    // Watch CPU share of the robot's tasks and warn when one stops, overloads the CPU or misses deadlines
+    Task_Monitor::Watch("User Operator Control (PROS)", nullptr, true);
+    Task_Monitor::Watch("Command Scheduler Task", "Command Scheduler");
+    Task_Monitor::Watch("Power Governor Task", "Power Governor");
+    Task_Monitor::Watch("Traction Control Task", "Traction Control");
+    Task_Monitor::Watch("Telemetry Sample Task", "Telemetry Sample");
+    Task_Monitor::Watch("Telemetry Flush Task");
+    Task_Monitor::Watch("Deferred Log Task");
+    Task_Monitor::Watch("Match Recorder Task");
+    Task_Monitor::Watch("Flight Recorder Task");
+    Task_Monitor::Watch("Thermal Model Task");
+    Task_Monitor::Watch("Controller Display Task");
+    Task_Monitor::Watch("Tuning Console Task");
+    Task_Monitor::Watch("Driver Macro Task", nullptr, true);
+    Task_Monitor::Watch("Task Monitor Task");
+    Task_Monitor::Start();
+
+    // Dump the last few seconds of telemetry if a control loop stalls or the robot is disabled
+    Flight_Recorder::Watch("Command Scheduler Task", "Command Scheduler", 200);
+    Flight_Recorder::Watch("Power Governor Task", "Power Governor", 500);
+    Flight_Recorder::Watch("Traction Control Task", "Traction Control", 200);
+    Flight_Recorder::Start();
+
+    // Record this match; replaying a recorded match is turned on from the selector screen
+    Match_Recorder::Start(master);
+
+    // Stream telemetry to tools/telemetry_viewer.py (takes over the serial terminal)
+    // Telemetry_Stream::Start();
+
+    // Time the control math and compare it with tools/benchmark_compare.py (blocks for about a second)
+    // Micro_Benchmark::Run();
+}
+
+void PlayDriverControl(const ControllerSnapshot &macroInput);
+
+/*** @brief Ejects rings of the other alliance's colour, if an alliance has been chosen */
+void StartRingSorting() {
+    switch (Config_Store::Get().alliance) {
+        case Config_Store::RED:
+            Intake_Control::StartSorting(Intake_Control::BLUE_RING);
+            break;
+        case Config_Store::BLUE:
+            Intake_Control::StartSorting(Intake_Control::RED_RING);
+            break;
+        default:
+            Intake_Control::StopSorting();
+            break;
+    }
+}
 
 /*** @brief Runs Autonomous period functions */
 void autonomous() {
-    // Coordinates
-    /*
-    pros::lcd::initialize(); // initialize brain screen
-    // print position to brain screen
-    pros::Task screen_task([&]() {
-        while (true) {
-            // print robot location to the brain screen
-            pros::lcd::print(0, "X: %f", robotDevices.chassis.getPose().x); // x
-            pros::lcd::print(1, "Y: %f", robotDevices.chassis.getPose().y); // y
-            pros::lcd::print(2, "Theta: %f", robotDevices.chassis.getPose().theta); // heading
-            // delay to save resources
-            pros::delay(20);
-        }
-    });*/
+    // Driver control commands must not run during autonomous, and lemlib owns the drive motors
+    Command_Scheduler::ClearDefaultCommands();
+    Command_Scheduler::SetPeriodic(nullptr);
+    Velocity_Drive::Stop();
+    StartRingSorting();
+
+    // Draw the robot's pose, odometry trail and path over the field
+    Field_Map::Show();
 
     // Retrieve the selected autonomous mode from the BrainUI.
-    int selectedMode = ui.selectedAuton;
+    int selectedMode = Match_Recorder::SelectAutonomous(ui.selectedAuton);
     // Autonomous override
     // selectedMode = 0;
 
-    // Red SOLO AWP   1
-    // Blue SOLO AWP  2
-    // Red GOAL RUSH  3
-    // Blue GOAL RUSH 4
-    // Skills         5
-
-    // Determine which autonomous routine to execute based on the selected mode.
-    switch (selectedMode)
-    {
-        case 0:
-            break;
-        case 1:
-            break;
-        case 2:
-            break;
-        case 3:
-            break;
-        case 5:
-            break;
+    // Play back a recorded driver run through the driver control code
+    if (selectedMode == Autonomous_Manager::MACRO) {
+        Driver_Macro::PlayLatest(PlayDriverControl);
+        return;
     }
+
+    // Run the selected routine; the selector's button IDs are Autonomous_Manager routines
+    autonManager.Run(selectedMode);
 }
 
 /*** @brief Runs when initialized by VEX Field Controller */
@@ -91,18 +170,42 @@ void competition_initialize() {
  * and right wheels, where each joystick controls one side of the drivetrain.
  */
 void DrivetrainDriverControl() {
+    // Pressing Left switches between open-loop and closed-loop velocity tank drive
+    static bool wasTogglePressed = false;
+    bool togglePressed = input.GetDigital(E_CONTROLLER_DIGITAL_LEFT);
+    if (togglePressed && !wasTogglePressed) {
+        if (Velocity_Drive::IsRunning()) {
+            Velocity_Drive::Stop();
+            Controller_Display::Rumble(".");
+        } else {
+            Velocity_Drive::Start();
+            Controller_Display::Rumble("..");
+        }
+    }
+    wasTogglePressed = togglePressed;
+
     // Read the Y-axis values from the controller's analog sticks.
     // rightY controls the right side of the drivetrain.
     // leftY controls the left side of the drivetrain.
-    int rightY = master.get_analog(E_CONTROLLER_ANALOG_RIGHT_Y);
-    int leftY = master.get_analog(E_CONTROLLER_ANALOG_LEFT_Y);
+    int rightY = input.GetAnalog(E_CONTROLLER_ANALOG_RIGHT_Y);
+    int leftY = input.GetAnalog(E_CONTROLLER_ANALOG_LEFT_Y);
 
     // Apply tank drive control to the drivetrain.
     // The tank method from lemlibs takes two arguments:
     // The first argument is the power for the left side (negative of leftY to match joystick direction).
     // The second argument is the power for the right side (rightY directly from joystick).
-    robotDevices.leftMotors.move(leftY); // Negative power for counter rotation
-    robotDevices.rightMotors.move(rightY);
+    // Both sides are shaped by the throttle curve table, then scaled by the power governor so
+    // turning ratios survive current limiting.
+    int leftPower = robotDevices.throttleCurve.Lookup(leftY);
+    int rightPower = robotDevices.throttleCurve.Lookup(rightY);
+    // In velocity mode the sticks set wheel speed targets and the velocity loop drives the motors.
+    if (Velocity_Drive::IsRunning()) {
+        Velocity_Drive::Update(Power_Governor::ScaleDrive(leftPower), Power_Governor::ScaleDrive(rightPower));
+        return;
+    }
+
+    robotDevices.leftMotors.move(Power_Governor::ScaleDrive(leftPower)); // Negative power for counter rotation
+    robotDevices.rightMotors.move(Power_Governor::ScaleDrive(rightPower));
 }
 
 /**
@@ -113,14 +216,21 @@ void DrivetrainDriverControl() {
  * - Pressing the Right button will deactivate the clamp (release it).
  */
 void MogoClampDriverControl() {
+    bool wasClamped = robot.mogoClamp.IsClamped();
+
     // Check if the Y button is pressed on the controller.
     // If pressed, activate the clamp to secure the mobile goal.
-    if (master.get_digital(E_CONTROLLER_DIGITAL_L1)) {
+    if (input.GetDigital(E_CONTROLLER_DIGITAL_L1)) {
         robot.mogoClamp.Clamp();
     }
     else {
         robot.mogoClamp.Unclamp();
     }
+
+    // Let the driver feel the clamp engage
+    if (robot.mogoClamp.IsClamped() && !wasClamped) {
+        Controller_Display::Rumble(".");
+    }
 }
 
 /**
@@ -133,13 +243,13 @@ void MogoClampDriverControl() {
 void DoinkerDriverControl() {
     // Check if the Y button is pressed on the controller.
     // If pressed, raise the doinker
-    if (master.get_digital(E_CONTROLLER_DIGITAL_B)) {
+    if (input.GetDigital(E_CONTROLLER_DIGITAL_B)) {
         robot.doinker.Raise();
     }
 
     // Check if the Right button is pressed on the controller.
     // If pressed, lower the doinker
-    if (master.get_digital(E_CONTROLLER_DIGITAL_DOWN)) {
+    if (input.GetDigital(E_CONTROLLER_DIGITAL_DOWN)) {
         robot.doinker.Lower();
     }
 }
@@ -156,12 +266,12 @@ void ArmDriverControl() {
 
     // Check if the Y button is pressed.
     // If pressed, raise arm
-    if (master.get_digital(E_CONTROLLER_DIGITAL_Y)) {
+    if (input.GetDigital(E_CONTROLLER_DIGITAL_Y)) {
         robot.lift.Raise();
     }
     // Check if the Right button is pressed.
     // If pressed, lower arm
-    else if (master.get_digital(E_CONTROLLER_DIGITAL_RIGHT)) {
+    else if (input.GetDigital(E_CONTROLLER_DIGITAL_RIGHT)) {
         robot.lift.Lower();
     }
     // If neither L2 nor L1 is pressed.
@@ -182,12 +292,12 @@ void ArmDriverControl() {
 void IntakeDriverControl() {
     // Check if the R1 button is pressed.
     // If pressed, spin intake forward with full power (100%)
-    if (master.get_digital(E_CONTROLLER_DIGITAL_R1)) {
+    if (input.GetDigital(E_CONTROLLER_DIGITAL_R1)) {
         robot.intake.Intake(127);
     }
     // Check if the R2 button is pressed.
     // If pressed, spin intake backward with full power (100%)
-    else if (master.get_digital(E_CONTROLLER_DIGITAL_R2)) {
+    else if (input.GetDigital(E_CONTROLLER_DIGITAL_R2)) {
         robot.intake.Intake(127);
 
     }
@@ -198,11 +308,60 @@ void IntakeDriverControl() {
     }
 }
 
+/**
+ * @brief Runs one driver control iteration with input played back from a driver macro.
+ *
+ * @param macroInput The corrected controller input for this iteration.
+ */
+void PlayDriverControl(const ControllerSnapshot &macroInput) {
+    input = macroInput;
+    DrivetrainDriverControl();
+    MogoClampDriverControl();
+    ArmDriverControl();
+    IntakeDriverControl();
+    DoinkerDriverControl();
+}
+
+/**
+ * @brief Starts or stops recording a driver macro when the Up button is pressed.
+ */
+void MacroDriverControl() {
+    static bool wasRecordPressed = false;
+    bool recordPressed = input.GetDigital(E_CONTROLLER_DIGITAL_UP);
+    if (recordPressed && !wasRecordPressed) {
+        if (Driver_Macro::IsRecording()) {
+            Driver_Macro::StopRecording();
+            Controller_Display::Rumble("..");
+        } else if (Driver_Macro::StartRecording()) {
+            Controller_Display::Rumble("-");
+        }
+    }
+    wasRecordPressed = recordPressed;
+
+    Driver_Macro::Record(input);
+}
+
+/**
+ * @brief Reads the controller once per scheduler cycle so every driver command sees the same input.
+ */
+void PollDriverInput() {
+    input = Match_Recorder::Poll();
+    MacroDriverControl();
+}
+
+/*** @brief Driver control functions, run as the default commands of their subsystems */
+Function_Command driveCommand(DrivetrainDriverControl, DRIVETRAIN);
+Function_Command liftCommand(ArmDriverControl, LIFT);
+Function_Command intakeCommand(IntakeDriverControl, INTAKE);
+Function_Command mogoClampCommand(MogoClampDriverControl, MOGO_CLAMP);
+Function_Command doinkerCommand(DoinkerDriverControl, DOINKER);
+
 /**
  * @brief Executes the Driver Control (opcontrol) tasks while the robot is enabled.
  *
- * This function runs in an infinite loop while the robot is under operator control.
- * It handles the control of the drivetrain, mobile goal clamp, arm, and intake systems.
+ * This function hands the drivetrain, mobile goal clamp, arm, intake and doinker
+ * controls to the command scheduler as default commands, then keeps the controller
+ * screen up to date while the robot is under operator control.
  */
 void opcontrol() {
 
@@ -216,12 +375,24 @@ void opcontrol() {
 
     //ui.DisplayMatchImage();
 
+    // End a match routine still running from an autonomous period cut short
+    autonManager.Stop();
+    StartRingSorting();
+
+    // Driver control runs on the command scheduler; commands such as the arm PID
+    // take over a subsystem from its driver command until they finish
+    Command_Scheduler::SetPeriodic(PollDriverInput);
+    Command_Scheduler::SetDefaultCommand(DRIVETRAIN, &driveCommand);
+    Command_Scheduler::SetDefaultCommand(LIFT, &liftCommand);
+    Command_Scheduler::SetDefaultCommand(INTAKE, &intakeCommand);
+    Command_Scheduler::SetDefaultCommand(MOGO_CLAMP, &mogoClampCommand);
+    Command_Scheduler::SetDefaultCommand(DOINKER, &doinkerCommand);
+
+    // Driver control is timed by the scheduler's "Command Scheduler" profile; this loop only posts status
     while (true) {
-        DrivetrainDriverControl();
-        MogoClampDriverControl();
-        ArmDriverControl();
-        IntakeDriverControl();
-        DoinkerDriverControl();
+        // Post status for the controller screen; only changed rows are sent
+        Controller_Display::Print(0, "Arm %6.1f", robot.lift.GetPosition() / 100.0);
+        Controller_Display::Print(1, "Clamp %s", robot.mogoClamp.IsClamped() ? "ON" : "OFF");
 
         // Small delay
         delay(25);
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""Checks micro-benchmark results from src/Micro_Benchmark.cpp for regressions.
+
+Usage:
+    benchmark_compare.py bench_000.csv [baseline.csv] [--tolerance PERCENT]
+
+Either file may be a bench_NNN.csv from the SD card or a captured terminal log;
+only lines starting with "BENCH" are read. The brain reports timings only, so
+regressions are judged here, against a baseline: a run saved from a brain and
+kept as the reference. A benchmark fails if it is more than the tolerance
+(default 10%) slower than its baseline time. Without a baseline, the results
+are listed with no status. Exits non-zero if anything failed.
+"""
+
+import sys
+
+VERSION = "2"
+
+
+def load(path):
+    results = {}
+    with open(path) as file:
+        for line in file:
+            fields = line.strip().split(",")
+            if len(fields) < 2 or fields[0] != "BENCH":
+                continue
+            if fields[1] != VERSION or len(fields) != 4:
+                raise SystemExit(f"{path}: unsupported results version {fields[1]}")
+            results[fields[2]] = int(fields[3])
+    return results
+
+
+def main():
+    args = sys.argv[1:]
+    tolerance = 10.0
+    if "--tolerance" in args:
+        index = args.index("--tolerance")
+        tolerance = float(args[index + 1])
+        del args[index:index + 2]
+
+    if not args:
+        print(__doc__)
+        return 1
+
+    current = load(args[0])
+    baseline = load(args[1]) if len(args) > 1 else {}
+    failures = 0
+
+    print(f"{'benchmark':<18}{'ns':>8}{'baseline':>10}{'limit':>8}{'change':>9}  status")
+    for name, nanoseconds in current.items():
+        status = "-"
+        change = ""
+        reference = ""
+        limit = ""
+        if name in baseline:
+            previous = baseline[name]
+            reference = str(previous)
+            limit = str(int(previous * (1 + tolerance / 100)))
+            status = "ok"
+            if previous > 0:
+                percent = (nanoseconds - previous) * 100.0 / previous
+                change = f"{percent:+.1f}%"
+                if percent > tolerance:
+                    status = "regressed"
+                    failures += 1
+        print(f"{name:<18}{nanoseconds:>8}{reference:>10}{limit:>8}{change:>9}  {status}")
+
+    for name in baseline.keys() - current.keys():
+        print(f"{name:<18} missing from results")
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
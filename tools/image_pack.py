@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""Packs a Brain screen image into the compressed format read by src/Image_Asset.cpp.
+
+Usage:
+    image_pack.py INPUT OUTPUT
+
+INPUT is either a C array from the LVGL image converter (its 32-bit true color
+block is used) or a binary PPM (P6) image. OUTPUT is normally a file in usd/,
+which is copied to the root of the SD card and loaded from there, so it is not
+part of the uploaded program. Pixels are stored as 24-bit BGR and
+compressed as a single LZ4 block, which the brain decodes once when the image
+is first shown.
+"""
+
+import re
+import struct
+import sys
+
+MAGIC = b"6741IMG\0"
+FORMAT_LZ4_BGR888 = 1
+MIN_MATCH = 4
+MAX_OFFSET = 65535
+SEARCH_DEPTH = 64
+
+
+def read_lvgl_header(path):
+    text = open(path).read()
+    # The descriptor lists cf, always_zero, reserved, w, h
+    descriptor = re.search(r"lv_img_dsc_t\s+\w+\s*=\s*\{(.*?)\}", text, re.S).group(1)
+    width, height = (int(value) for value in re.findall(r"^\s*(\d+),", descriptor, re.M)[2:4])
+    block = re.search(r"#if LV_COLOR_DEPTH == 32\n(.*?)#endif", text, re.S).group(1)
+    block = "\n".join(line for line in block.split("\n") if not line.strip().startswith("/*"))
+    bgra = bytes(int(value, 16) for value in re.findall(r"0x([0-9a-fA-F]{2})", block))
+    if len(bgra) != width * height * 4:
+        raise SystemExit(f"{path}: expected {width * height * 4} bytes of pixels, found {len(bgra)}")
+    return width, height, b"".join(bgra[i:i + 3] for i in range(0, len(bgra), 4))
+
+
+def read_ppm(path):
+    data = open(path, "rb").read()
+    fields = re.match(rb"P6\s+(?:#.*\s+)*(\d+)\s+(\d+)\s+(\d+)\s", data)
+    if fields is None or int(fields.group(3)) != 255:
+        raise SystemExit(f"{path}: only 8-bit binary PPM images are supported")
+    width, height = int(fields.group(1)), int(fields.group(2))
+    rgb = data[fields.end():fields.end() + width * height * 3]
+    return width, height, b"".join(rgb[i:i + 3][::-1] for i in range(0, len(rgb), 3))
+
+
+def write_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def compress(data):
+    """Greedy LZ4 block compression with a short hash chain."""
+    out = bytearray()
+    chains = {}
+    anchor = 0
+    position = 0
+    # LZ4 requires the last 5 bytes to be literals and no match to start in the last 12
+    limit = len(data) - 12
+
+    def emit(literal_end, offset, match):
+        literals = literal_end - anchor
+        out.append(min(literals, 15) << 4 | (min(match - MIN_MATCH, 15) if match else 0))
+        if literals >= 15:
+            write_length(out, literals - 15)
+        out.extend(data[anchor:literal_end])
+        if match:
+            out.extend((offset & 0xFF, offset >> 8))
+            if match - MIN_MATCH >= 15:
+                write_length(out, match - MIN_MATCH - 15)
+
+    while position < limit:
+        key = data[position:position + MIN_MATCH]
+        best, best_offset = 0, 0
+        for candidate in reversed(chains.get(key, [])[-SEARCH_DEPTH:]):
+            if position - candidate > MAX_OFFSET:
+                break
+            length = MIN_MATCH
+            longest = len(data) - 5 - position
+            while length < longest and data[candidate + length] == data[position + length]:
+                length += 1
+            if length > best:
+                best, best_offset = length, position - candidate
+        chains.setdefault(key, []).append(position)
+
+        if best < MIN_MATCH:
+            position += 1
+            continue
+
+        emit(position, best_offset, best)
+        for skipped in range(position + 1, min(position + best, limit)):
+            chains.setdefault(data[skipped:skipped + MIN_MATCH], []).append(skipped)
+        position += best
+        anchor = position
+
+    emit(len(data), 0, 0)
+    return bytes(out)
+
+
+def decompress(block):
+    out = bytearray()
+    index = 0
+    while index < len(block):
+        token = block[index]
+        index += 1
+        literals = token >> 4
+        if literals == 15:
+            while True:
+                literals += block[index]
+                index += 1
+                if block[index - 1] != 255:
+                    break
+        out += block[index:index + literals]
+        index += literals
+        if index >= len(block):
+            break
+        offset = block[index] | block[index + 1] << 8
+        index += 2
+        match = token & 15
+        if match == 15:
+            while True:
+                match += block[index]
+                index += 1
+                if block[index - 1] != 255:
+                    break
+        for _ in range(match + MIN_MATCH):
+            out.append(out[-offset])
+    return bytes(out)
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        return 1
+
+    source = sys.argv[1]
+    width, height, pixels = read_ppm(source) if source.endswith(".ppm") else read_lvgl_header(source)
+    block = compress(pixels)
+    if decompress(block) != pixels:
+        raise SystemExit("compressed image did not round-trip")
+
+    with open(sys.argv[2], "wb") as out:
+        out.write(MAGIC)
+        out.write(struct.pack("<BHHI", FORMAT_LZ4_BGR888, width, height, len(block)))
+        out.write(block)
+
+    print(f"{width}x{height}: {width * height * 4} bytes as true color, {len(block) + 17} packed")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
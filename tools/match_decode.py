@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+"""Prints the events in a match log written by src/Match_Recorder.cpp.
+
+Usage:
+    match_decode.py match_000.bin [--sensors]
+
+Controller, competition and autonomous records are always printed; sensor
+snapshots are only printed with --sensors. Copy a log to /usd/replay.bin to
+play its driver input back on the robot.
+"""
+
+import struct
+import sys
+
+MAGIC = b"6741MRC\0"
+BUTTONS = ["L1", "L2", "R1", "R2", "UP", "DOWN", "LEFT", "RIGHT", "X", "B", "Y", "A"]
+RECORDS = {
+    1: ("controller", "<4bH"),
+    2: ("competition", "<B"),
+    3: ("autonomous", "<i"),
+    4: ("sensors", "<4f3i"),
+}
+
+
+def describe(kind, values):
+    if kind == "controller":
+        pressed = [name for bit, name in enumerate(BUTTONS) if values[4] >> bit & 1]
+        return f"LX={values[0]} LY={values[1]} RX={values[2]} RY={values[3]} buttons={'+'.join(pressed) or '-'}"
+    if kind == "competition":
+        status = values[0]
+        mode = "disabled" if status & 1 else ("autonomous" if status & 2 else "driver")
+        return f"{mode}{' (field)' if status & 4 else ''}"
+    if kind == "autonomous":
+        return f"selected={values[0]}"
+    return "x={:.2f} y={:.2f} theta={:.2f} imu={:.2f} arm={} vertical={} horizontal={}".format(*values)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 1
+
+    with open(sys.argv[1], "rb") as log:
+        data = log.read()
+
+    if data[:8] != MAGIC:
+        print(f"{sys.argv[1]} is not a match log")
+        return 1
+
+    offset = 10
+    while offset + 5 <= len(data):
+        record_type, time = struct.unpack_from("<BI", data, offset)
+        if record_type not in RECORDS:
+            break
+        kind, layout = RECORDS[record_type]
+        values = struct.unpack_from(layout, data, offset + 5)
+        offset += 5 + struct.calcsize(layout)
+        if kind != "sensors" or "--sensors" in sys.argv:
+            print(f"{time:>8} {kind:<12} {describe(kind, values)}")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Decodes telemetry logs written by src/Telemetry.cpp into CSV or Parquet.
+
+Usage:
+    telemetry_decode.py telem_000.bin [output.csv | output.parquet]
+
+The channel table is read from the file header, so logs recorded with an
+older TelemetryRecord layout still decode correctly.
+"""
+
+import csv
+import struct
+import sys
+
+MAGIC = b"6741TLM\0"
+TYPES = {0: "H", 1: "h", 2: "I", 3: "i", 4: "f"}
+
+
+def read_log(path):
+    with open(path, "rb") as log:
+        data = log.read()
+
+    if data[:8] != MAGIC:
+        raise ValueError(f"{path} is not a telemetry log")
+
+    version, record_size, channel_count = struct.unpack_from("<HHH", data, 8)
+    offset = 14
+    channels = []
+    for _ in range(channel_count):
+        name, kind, field_offset = struct.unpack_from("<16sBH", data, offset)
+        channels.append((name.rstrip(b"\0").decode(), TYPES[kind], field_offset))
+        offset += 19
+
+    rows = []
+    while offset + record_size <= len(data):
+        rows.append([struct.unpack_from("<" + kind, data, offset + field)[0] for _, kind, field in channels])
+        offset += record_size
+
+    return [name for name, _, _ in channels], rows
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 1
+
+    source = sys.argv[1]
+    target = sys.argv[2] if len(sys.argv) > 2 else source.rsplit(".", 1)[0] + ".csv"
+    names, rows = read_log(source)
+
+    if target.endswith(".parquet"):
+        import pyarrow as pa
+        import pyarrow.parquet as pq
+
+        columns = list(zip(*rows)) if rows else [[] for _ in names]
+        pq.write_table(pa.table({name: list(col) for name, col in zip(names, columns)}), target)
+    else:
+        with open(target, "w", newline="") as out:
+            writer = csv.writer(out)
+            writer.writerow(names)
+            writer.writerows(rows)
+
+    print(f"Decoded {len(rows)} records to {target}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
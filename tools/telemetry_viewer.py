@@ -0,0 +1,253 @@
+#!/usr/bin/env python3
+"""Live receiver for the serial telemetry stream sent by src/Telemetry_Stream.cpp.
+
+Usage:
+    telemetry_viewer.py PORT [--channels poseX,poseY] [--period 10] [--record out.csv] [--plot]
+    telemetry_viewer.py loopback [...]
+
+PORT is the brain's user serial port (pyserial required). "loopback" runs
+against an in-process stand-in for the brain that speaks the same protocol,
+which is useful for testing the viewer without a robot.
+"""
+
+import argparse
+import csv
+import math
+import queue
+import struct
+import sys
+import threading
+import time
+
+SUBSCRIBE = 0x01
+DESCRIBE = 0x02
+DATA = 0x10
+TYPES = {0: "H", 1: "h", 2: "I", 3: "i", 4: "f"}
+DESCRIBE_ENTRIES = 13  # channel entries that fit in one 256 byte DESCRIBE frame
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_index, run = 0, 1
+    for byte in data:
+        if byte:
+            out.append(byte)
+            run += 1
+        if byte == 0 or run == 0xFF:
+            out[code_index] = run
+            code_index = len(out)
+            out.append(0)
+            run = 1
+    out[code_index] = run
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    index = 0
+    while index < len(data):
+        code = data[index]
+        index += 1
+        if code == 0 or index + code - 1 > len(data):
+            return None
+        out += data[index:index + code - 1]
+        index += code - 1
+        if code != 0xFF and index < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(payload):
+    crc = crc16(payload)
+    return b"\0" + cobs_encode(payload + bytes([crc & 0xFF, crc >> 8])) + b"\0"
+
+
+class FrameReader:
+    """Splits a byte stream into CRC-checked frames; anything else is plain text."""
+
+    def __init__(self):
+        self.pending = bytearray()
+
+    def feed(self, data):
+        self.pending += data
+        while b"\0" in self.pending:
+            chunk, _, rest = self.pending.partition(b"\0")
+            self.pending = bytearray(rest)
+            if not chunk:
+                continue
+            frame = cobs_decode(bytes(chunk))
+            if frame and len(frame) > 2 and crc16(frame[:-2]) == frame[-2] | frame[-1] << 8:
+                yield ("frame", frame[:-2])
+            else:
+                yield ("text", bytes(chunk).decode(errors="replace"))
+
+
+class SerialLink:
+    def __init__(self, port):
+        import serial
+
+        self.port = serial.Serial(port, 115200, timeout=0.05)
+
+    def write(self, data):
+        self.port.write(data)
+
+    def read(self):
+        return self.port.read(4096)
+
+
+class LoopbackLink:
+    """Stand-in for the brain that answers subscriptions with synthetic data."""
+
+    # Mirrors the channel table in src/Telemetry.cpp, so descriptions span several frames as they do on the brain
+    CHANNELS = [("timestamp", 2), ("poseX", 4), ("poseY", 4), ("poseTheta", 4)]
+    CHANNELS += [(name, 1) for name in ("leftVelocity", "rightVelocity", "armVelocity", "intakeVelocity",
+                                        "leftCurrent", "rightCurrent", "armCurrent", "intakeCurrent")]
+    CHANNELS += [("armP", 4), ("armI", 4), ("armD", 4), ("armAngle", 3), ("batteryVoltage", 0)]
+    CHANNELS += [(name, 4) for name in ("lateralP", "lateralI", "lateralD", "angularP", "angularI", "angularD")]
+
+    def __init__(self):
+        self.outbox = queue.Queue()
+        self.reader = FrameReader()
+        self.mask = 0
+        self.period = 0.01
+        threading.Thread(target=self.run, daemon=True).start()
+
+    def write(self, data):
+        for kind, frame in self.reader.feed(data):
+            if kind == "frame" and frame[0] == SUBSCRIBE:
+                mask, period = struct.unpack_from("<IH", frame, 1)
+                self.mask = (mask | 1) & ((1 << len(self.CHANNELS)) - 1) if mask else 0
+                self.period = max(period, 10) / 1000
+                described = [(name, kind, i) for i, (name, kind) in enumerate(self.CHANNELS) if self.mask >> i & 1]
+                for first in range(0, max(len(described), 1), DESCRIBE_ENTRIES):
+                    payload = struct.pack("<BHBB", DESCRIBE, int(self.period * 1000), len(described), first)
+                    for name, kind, index in described[first:first + DESCRIBE_ENTRIES]:
+                        payload += struct.pack("<16sBB", name.encode(), kind, index)
+                    self.outbox.put(encode_frame(payload))
+
+    def read(self):
+        try:
+            return self.outbox.get(timeout=0.05)
+        except queue.Empty:
+            return b""
+
+    def run(self):
+        start = time.time()
+        while True:
+            if self.mask:
+                t = time.time() - start
+                values = [int(t * 1000), 24 * math.cos(t), 24 * math.sin(t), math.degrees(t) % 360]
+                values += [int(600 * math.sin(t + i)) for i in range(8)]
+                values += [math.sin(t), math.cos(t), 0.0, int(3000 * math.sin(t)), 12800]
+                values += [math.sin(t + i) for i in range(6)]
+                payload = bytes([DATA])
+                for i, (name, kind) in enumerate(self.CHANNELS):
+                    if self.mask >> i & 1:
+                        payload += struct.pack("<" + TYPES[kind], values[i])
+                self.outbox.put(encode_frame(payload))
+            time.sleep(self.period)
+
+
+def subscribe(link, reader, mask, period, timeout=2.0):
+    """Sends a subscription and waits for the matching channel description."""
+    link.write(encode_frame(struct.pack("<BIH", SUBSCRIBE, mask, period)))
+    channels = {}
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        for kind, frame in reader.feed(link.read()):
+            if kind == "frame" and frame[0] == DESCRIBE:
+                # The description may span several frames; each says where its entries start
+                _, total, first = struct.unpack_from("<HBB", frame, 1)
+                for i in range((len(frame) - 5) // 18):
+                    name, kind, index = struct.unpack_from("<16sBB", frame, 5 + i * 18)
+                    channels[first + i] = (name.rstrip(b"\0").decode(), TYPES[kind], index)
+                if len(channels) == total:
+                    return [channels[i] for i in range(total)]
+    raise TimeoutError("brain did not answer the subscription")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port")
+    parser.add_argument("--channels", help="comma separated channel names (default: all)")
+    parser.add_argument("--period", type=int, default=10, help="sample period in ms")
+    parser.add_argument("--record", help="write received samples to this CSV file")
+    parser.add_argument("--plot", action="store_true", help="plot samples live (matplotlib required)")
+    parser.add_argument("--duration", type=float, help="stop after this many seconds")
+    args = parser.parse_args()
+
+    link = LoopbackLink() if args.port == "loopback" else SerialLink(args.port)
+    reader = FrameReader()
+
+    # Learn the channel table first, then ask for just the channels we want
+    channels = subscribe(link, reader, 0xFFFFFFFF, 1000)
+    if args.channels:
+        wanted = set(args.channels.split(","))
+        mask = sum(1 << index for name, _, index in channels if name in wanted)
+        channels = subscribe(link, reader, mask, args.period)
+    else:
+        channels = subscribe(link, reader, 0xFFFFFFFF, args.period)
+
+    names = [name for name, _, _ in channels]
+    layout = "<" + "".join(kind for _, kind, _ in channels)
+    writer = None
+    if args.record:
+        record_file = open(args.record, "w", newline="")
+        writer = csv.writer(record_file)
+        writer.writerow(names)
+
+    history = {name: [] for name in names}
+    if args.plot:
+        import matplotlib.pyplot as plt
+
+        plt.ion()
+        figure, axis = plt.subplots()
+        lines = {name: axis.plot([], [], label=name)[0] for name in names[1:]}
+        axis.legend()
+
+    started = time.time()
+    samples = 0
+    try:
+        while args.duration is None or time.time() - started < args.duration:
+            for kind, frame in reader.feed(link.read()):
+                if kind == "text":
+                    print(frame, end="" if frame.endswith("\n") else "\n")
+                    continue
+                if frame[0] != DATA or len(frame) - 1 != struct.calcsize(layout):
+                    continue
+                values = struct.unpack_from(layout, frame, 1)
+                samples += 1
+                if writer:
+                    writer.writerow(values)
+                for name, value in zip(names, values):
+                    history[name] = (history[name] + [value])[-500:]
+                if not args.plot and not writer:
+                    print(", ".join(f"{n}={v:.3f}" if isinstance(v, float) else f"{n}={v}" for n, v in zip(names, values)))
+
+            if args.plot and samples:
+                for name, line in lines.items():
+                    line.set_data(history[names[0]], history[name])
+                axis.relim()
+                axis.autoscale_view()
+                plt.pause(0.001)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        link.write(encode_frame(struct.pack("<BIH", SUBSCRIBE, 0, 0)))
+
+    print(f"Received {samples} samples")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())